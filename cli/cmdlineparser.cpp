@@ -318,7 +318,7 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
                 return false;
             }
             // when "style" is enabled, also enable "warning", "performance" and "portability"
-            if (_settings->isEnabled("style")) {
+            if (_settings->isEnabled(Settings::Style)) {
                 _settings->addEnabled("warning");
                 _settings->addEnabled("performance");
                 _settings->addEnabled("portability");
@@ -664,6 +664,60 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
             }
         }
 
+        // Set maximum number of template instantiations to expand
+        else if (std::strncmp(argv[i], "--max-template-instantiations=", 30) == 0) {
+            std::istringstream iss(30+argv[i]);
+            if (!(iss >> _settings->_maxTemplateInstantiations)) {
+                PrintMessage("cppcheck: argument to '--max-template-instantiations=' is not a number.");
+                return false;
+            }
+        }
+
+        // Set maximum number of tokens that template expansion may add
+        else if (std::strncmp(argv[i], "--max-template-tokens=", 22) == 0) {
+            std::istringstream iss(22+argv[i]);
+            if (!(iss >> _settings->_maxTemplateTokens)) {
+                PrintMessage("cppcheck: argument to '--max-template-tokens=' is not a number.");
+                return false;
+            }
+        }
+
+        // Set maximum number of live tokens for a configuration
+        else if (std::strncmp(argv[i], "--max-tokens=", 13) == 0) {
+            std::istringstream iss(13+argv[i]);
+            if (!(iss >> _settings->_maxTokens)) {
+                PrintMessage("cppcheck: argument to '--max-tokens=' is not a number.");
+                return false;
+            }
+        }
+
+        // Set maximum estimated memory for a configuration
+        else if (std::strncmp(argv[i], "--max-memory=", 13) == 0) {
+            std::istringstream iss(13+argv[i]);
+            if (!(iss >> _settings->_maxMemory)) {
+                PrintMessage("cppcheck: argument to '--max-memory=' is not a number.");
+                return false;
+            }
+        }
+
+        // Set maximum time for checking a file
+        else if (std::strncmp(argv[i], "--max-time=", 11) == 0) {
+            std::istringstream iss(11+argv[i]);
+            if (!(iss >> _settings->_maxTime)) {
+                PrintMessage("cppcheck: argument to '--max-time=' is not a number.");
+                return false;
+            }
+        }
+
+        // Set maximum time for checking a configuration
+        else if (std::strncmp(argv[i], "--max-config-time=", 18) == 0) {
+            std::istringstream iss(18+argv[i]);
+            if (!(iss >> _settings->_maxConfigTime)) {
+                PrintMessage("cppcheck: argument to '--max-config-time=' is not a number.");
+                return false;
+            }
+        }
+
         // Print help
         else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
             _pathnames.clear();
@@ -687,7 +741,7 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
         }
     }
 
-    if (_settings->isEnabled("unusedFunction") && _settings->_jobs > 1) {
+    if (_settings->isEnabled(Settings::UnusedFunction) && _settings->_jobs > 1) {
         PrintMessage("cppcheck: unusedFunction check can't be used with '-j' option, so it's disabled.");
     }
 
@@ -806,6 +860,23 @@ void CmdLineParser::PrintHelp()
               "                         before skipping it. Default is '12'. If used together\n"
               "                         with '--force', the last option is the one that is\n"
               "                         effective.\n"
+              "    --max-config-time=<seconds>\n"
+              "                         Abort checking a configuration after this many\n"
+              "                         seconds. Default is '0' (no limit).\n"
+              "    --max-template-instantiations=<limit>\n"
+              "                         Maximum number of template instantiations to expand\n"
+              "                         in a file. Default is '10000'.\n"
+              "    --max-template-tokens=<limit>\n"
+              "                         Maximum number of tokens that template expansion may\n"
+              "                         add to a file. Default is '1000000'.\n"
+              "    --max-memory=<MB>    Abort checking a configuration when its tokens and\n"
+              "                         symbol database are estimated to need this many\n"
+              "                         megabytes. Default is '0' (no limit).\n"
+              "    --max-tokens=<limit> Abort checking a configuration when it needs more\n"
+              "                         tokens than this at once. Default is '0' (no limit).\n"
+              "    --max-time=<seconds> Abort checking a file after this many seconds. The\n"
+              "                         configurations that are left are not checked.\n"
+              "                         Default is '0' (no limit).\n"
               "    --platform=<type>    Specifies platform specific types and sizes. The\n"
               "                         available platforms are:\n"
               "                          * unix32\n"
@@ -40,6 +40,7 @@ CppCheckExecutor::CppCheckExecutor()
 
 CppCheckExecutor::~CppCheckExecutor()
 {
+    flushErrors();
 }
 
 bool CppCheckExecutor::parseFromArgs(CppCheck *cppcheck, int argc, const char* const argv[])
@@ -177,6 +178,7 @@ int CppCheckExecutor::check(int argc, const char* const argv[])
         for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i) {
             returnValue += cppCheck.check(i->first);
             processedsize += i->second;
+            flushErrors();
             if (!settings._errorsOnly)
                 reportStatus(c + 1, _files.size(), processedsize, totalfilesize);
             c++;
@@ -197,7 +199,7 @@ int CppCheckExecutor::check(int argc, const char* const argv[])
 
         cppCheck.tooManyConfigsError("",0U);
 
-        if (settings.isEnabled("missingInclude") && Preprocessor::missingIncludeFlag) {
+        if (settings.isEnabled(Settings::MissingInclude) && Preprocessor::missingIncludeFlag) {
             const std::list<ErrorLogger::ErrorMessage::FileLocation> callStack;
             ErrorLogger::ErrorMessage msg(callStack,
                                           Severity::information,
@@ -216,6 +218,7 @@ int CppCheckExecutor::check(int argc, const char* const argv[])
     if (settings._xml) {
         reportErr(ErrorLogger::ErrorMessage::getXMLFooter(settings._xml_version));
     }
+    flushErrors();
 
     _settings = 0;
     if (returnValue)
@@ -231,11 +234,31 @@ void CppCheckExecutor::reportErr(const std::string &errmsg)
         return;
 
     _errorList.insert(errmsg);
-    std::cerr << errmsg << std::endl;
+    _errorBuffer += errmsg;
+    _errorBuffer += '\n';
+
+    // Write out large batches right away. With -j the results of the
+    // workers are written at once, to keep them next to the progress
+    // lines that ThreadExecutor writes to std::cout directly, and so that
+    // they are not lost if the process is killed.
+    if (_errorBuffer.size() >= 0x10000 || (_settings && _settings->_jobs > 1))
+        flushErrors();
+}
+
+void CppCheckExecutor::flushErrors()
+{
+    if (_errorBuffer.empty())
+        return;
+
+    std::cerr.write(_errorBuffer.data(), static_cast<std::streamsize>(_errorBuffer.size()));
+    std::cerr.flush();
+    _errorBuffer.clear();
 }
 
 void CppCheckExecutor::reportOut(const std::string &outmsg)
 {
+    // Keep the order of errors and other output
+    flushErrors();
     std::cout << outmsg << std::endl;
 }
 
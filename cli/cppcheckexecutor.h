@@ -91,10 +91,16 @@ protected:
 
     /**
      * Helper function to print out errors. Appends a line change.
+     * The message is buffered, see flushErrors().
      * @param errmsg String printed to error stream
      */
     void reportErr(const std::string &errmsg);
 
+    /**
+     * Write the buffered error messages to the error stream.
+     */
+    void flushErrors();
+
     /**
      * @brief Parse command line args and get settings and file lists
      * from there.
@@ -118,6 +124,14 @@ private:
      */
     std::set<std::string> _errorList;
 
+    /**
+     * Error messages not yet written to the error stream. The error stream
+     * is unbuffered, so the messages are collected here and written in one
+     * go before other output is written or when the buffer is large. With
+     * -j nothing is held back.
+     */
+    std::string _errorBuffer;
+
     /**
      * Filename associated with size of file
      */
@@ -155,6 +155,7 @@ bool FileLister::fileExists(const std::string &path)
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <glob.h>
+#include <dirent.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <limits.h>
@@ -180,7 +181,8 @@ std::string FileLister::getAbsolutePath(const std::string& path)
     return absolute_path;
 }
 
-void FileLister::recursiveAddFiles2(std::set<std::string> &seen_paths,
+void FileLister::recursiveAddFiles2(std::set<FileId> &seen_dirs,
+                                    std::set<std::string> &seen_files,
                                     std::map<std::string, std::size_t> &files,
                                     const std::string &path)
 {
@@ -196,43 +198,129 @@ void FileLister::recursiveAddFiles2(std::set<std::string> &seen_paths,
         if (filename == "." || filename == ".." || filename.length() == 0)
             continue;
 
-        // Determine absolute path. Empty filename if path does not exist
-        const std::string absolute_path = getAbsolutePath(filename);
-        if (absolute_path.empty())
-            continue;
-
-        // Did we already process this entry?
-        if (seen_paths.find(absolute_path) != seen_paths.end())
-            continue;
-
         if (filename[filename.length()-1] != '/') {
             // File
 
             if (Path::sameFileName(path,filename) || Path::acceptFile(filename)) {
-                seen_paths.insert(absolute_path);
+                // Did we already process this entry?
+                const std::string absolute_path = getAbsolutePath(filename);
+                if (absolute_path.empty() || !seen_files.insert(absolute_path).second)
+                    continue;
 
                 struct stat sb;
-                if (stat(absolute_path.c_str(), &sb) == 0) {
-                    // Limitation: file sizes are assumed to fit in a 'size_t'
-                    files[filename] = static_cast<std::size_t>(sb.st_size);
-                } else
-                    files[filename] = 0;
+                if (stat(filename.c_str(), &sb) != 0)
+                    continue;
+
+                // Limitation: file sizes are assumed to fit in a 'size_t'
+                files[filename] = static_cast<std::size_t>(sb.st_size);
             }
         } else {
             // Directory
-
-            seen_paths.insert(absolute_path);
-            recursiveAddFiles2(seen_paths, files, filename);
+            addDirectory(seen_dirs, seen_files, files, filename);
         }
     }
     globfree(&glob_results);
 }
 
+void FileLister::addDirectory(std::set<FileId> &seen_dirs,
+                              std::set<std::string> &seen_files,
+                              std::map<std::string, std::size_t> &files,
+                              const std::string &dirname)
+{
+    DIR *dir = opendir(dirname.c_str());
+    if (!dir)
+        return;
+
+    // Did we already process this directory?
+    struct stat dirsb;
+    if (fstat(dirfd(dir), &dirsb) != 0 || !seen_dirs.insert(FileId(dirsb.st_dev, dirsb.st_ino)).second) {
+        closedir(dir);
+        return;
+    }
+
+    // The absolute path of an entry that is not a symbolic link is the
+    // absolute path of the directory and its name
+    std::string absolute_dir = getAbsolutePath(dirname);
+    if (absolute_dir.empty()) {
+        closedir(dir);
+        return;
+    }
+    absolute_dir += '/';
+
+    std::set<std::string> subdirs;
+    while (const struct dirent *entry = readdir(dir)) {
+        // Skip ".", ".." and hidden files, like glob() does
+        if (entry->d_name[0] == '.' || entry->d_name[0] == '\0')
+            continue;
+
+#ifdef DT_DIR
+        addEntry(seen_files, files, subdirs, dirname + entry->d_name, absolute_dir + entry->d_name, entry->d_type);
+#else
+        addEntry(seen_files, files, subdirs, dirname + entry->d_name, absolute_dir + entry->d_name, 0);
+#endif
+    }
+    closedir(dir);
+
+    // Recurse after the directory is closed, to limit the number of open
+    // directory handles. The set keeps the traversal order deterministic.
+    for (std::set<std::string>::const_iterator it = subdirs.begin(); it != subdirs.end(); ++it)
+        addDirectory(seen_dirs, seen_files, files, *it);
+}
+
+void FileLister::addEntry(std::set<std::string> &seen_files,
+                          std::map<std::string, std::size_t> &files,
+                          std::set<std::string> &subdirs,
+                          const std::string &filename,
+                          const std::string &absolute_path,
+                          unsigned char type)
+{
+    struct stat sb;
+    bool haveStat = false;
+    bool isLink = false;
+    bool isDir = false;
+    bool isFile = false;
+#ifdef DT_DIR
+    if (type == DT_DIR)
+        isDir = true;
+    else if (type == DT_REG)
+        isFile = true;
+    else
+#else
+    (void)type;
+#endif
+    {
+        if (lstat(filename.c_str(), &sb) != 0)
+            return;
+        isLink = S_ISLNK(sb.st_mode);
+        if (isLink && stat(filename.c_str(), &sb) != 0)
+            return;
+        haveStat = true;
+        isDir = S_ISDIR(sb.st_mode);
+        isFile = S_ISREG(sb.st_mode);
+    }
+
+    if (isDir) {
+        subdirs.insert(filename + '/');
+    } else if (isFile && Path::acceptFile(filename)) {
+        // Did we already process this entry? Only a symbolic link can
+        // lead to a file that is listed by another path.
+        if (!seen_files.insert(isLink ? getAbsolutePath(filename) : absolute_path).second)
+            return;
+
+        if (!haveStat && stat(filename.c_str(), &sb) != 0)
+            return;
+
+        // Limitation: file sizes are assumed to fit in a 'size_t'
+        files[filename] = static_cast<std::size_t>(sb.st_size);
+    }
+}
+
 
 void FileLister::recursiveAddFiles(std::map<std::string, std::size_t> &files, const std::string &path)
 {
-    std::set<std::string> seen_paths;
-    recursiveAddFiles2(seen_paths, files, path);
+    std::set<FileId> seen_dirs;
+    std::set<std::string> seen_files;
+    recursiveAddFiles2(seen_dirs, seen_files, files, path);
 }
 
 bool FileLister::isDirectory(const std::string &path)
@@ -22,6 +22,11 @@
 #include <string>
 #include <set>
 #include <map>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
 
 /// @addtogroup CLI
 /// @{
@@ -54,9 +59,47 @@ public:
 #ifndef _WIN32
     static std::string getAbsolutePath(const std::string& path);
 
-    static void recursiveAddFiles2(std::set<std::string> &seen_paths,
+    /** @brief Identifies a directory by device and inode number */
+    typedef std::pair<dev_t, ino_t> FileId;
+
+    static void recursiveAddFiles2(std::set<FileId> &seen_dirs,
+                                   std::set<std::string> &seen_files,
                                    std::map<std::string, std::size_t> &files,
                                    const std::string &path);
+
+    /**
+     * @brief Add source files from the given directory and its subdirectories.
+     * The directory entries are read with readdir(), the entry type is used
+     * when the file system provides it so only symbolic links, entries of
+     * unknown type and accepted source files need a stat() call.
+     * @param seen_dirs directories that are already processed
+     * @param seen_files absolute paths of the files that are already processed
+     * @param files output map that associates the size of each file with its name
+     * @param dirname directory name, with a trailing '/'
+     */
+    static void addDirectory(std::set<FileId> &seen_dirs,
+                             std::set<std::string> &seen_files,
+                             std::map<std::string, std::size_t> &files,
+                             const std::string &dirname);
+
+    /**
+     * @brief Add one directory entry. A directory is added to subdirs and
+     * an accepted source file to files, unless it was already processed.
+     * @param seen_files absolute paths of the files that are already processed
+     * @param files output map that associates the size of each file with its name
+     * @param subdirs output set of subdirectories, with a trailing '/'
+     * @param filename path of the entry
+     * @param absolute_path absolute path of the entry, unless it is a
+     * symbolic link. The absolute path of a link is looked up.
+     * @param type dirent type of the entry. Types other than DT_DIR and
+     * DT_REG, such as DT_UNKNOWN (0) and DT_LNK, are resolved with stat().
+     */
+    static void addEntry(std::set<std::string> &seen_files,
+                         std::map<std::string, std::size_t> &files,
+                         std::set<std::string> &subdirs,
+                         const std::string &filename,
+                         const std::string &absolute_path,
+                         unsigned char type);
 #endif
 };
 
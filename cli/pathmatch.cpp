@@ -21,11 +21,23 @@
 #include <ctype.h>      // Borland: tolower
 
 PathMatch::PathMatch(const std::vector<std::string> &masks, bool caseSensitive)
-    : _masks(masks), _caseSensitive(caseSensitive)
+    : _maxDirectoryMaskLength(0), _caseSensitive(caseSensitive)
 {
-    if (!_caseSensitive)
-        for (std::vector<std::string>::iterator i = _masks.begin(); i != _masks.end(); ++i)
-            std::transform(i->begin(), i->end(), i->begin(), ::tolower);
+    for (std::vector<std::string>::const_iterator i = masks.begin(); i != masks.end(); ++i) {
+        if (i->empty())
+            continue;
+
+        std::string mask(*i);
+        if (!_caseSensitive)
+            std::transform(mask.begin(), mask.end(), mask.begin(), ::tolower);
+
+        if (mask[mask.length() - 1] == '/') {
+            _directoryMasks.insert(mask);
+            _maxDirectoryMaskLength = std::max(_maxDirectoryMaskLength, mask.length());
+        } else {
+            _fileMasks[mask.length()].insert(mask);
+        }
+    }
 }
 
 bool PathMatch::Match(const std::string &path) const
@@ -33,42 +45,45 @@ bool PathMatch::Match(const std::string &path) const
     if (path.empty())
         return false;
 
-    for (std::vector<std::string>::const_iterator iterMask = _masks.begin(); iterMask != _masks.end(); ++iterMask) {
-        const std::string& mask(*iterMask);
+    std::string findpath(path);
+    if (!_caseSensitive)
+        std::transform(findpath.begin(), findpath.end(), findpath.begin(), ::tolower);
 
-        std::string findpath(path);
-        if (!_caseSensitive)
-            std::transform(findpath.begin(), findpath.end(), findpath.begin(), ::tolower);
+    // Filtering filename
+    // Check if path ends with mask
+    // -ifoo.cpp matches (./)foo.c, src/foo.cpp and proj/src/foo.cpp
+    // -isrc/file.cpp matches src/foo.cpp and proj/src/foo.cpp
+    for (std::map<std::string::size_type, std::set<std::string> >::const_iterator it = _fileMasks.begin(); it != _fileMasks.end(); ++it) {
+        if (it->first > findpath.length())
+            break;
+        if (it->second.find(findpath.substr(findpath.length() - it->first)) != it->second.end())
+            return true;
+    }
 
-        // Filtering directory name
-        if (mask[mask.length() - 1] == '/') {
-            if (findpath[findpath.length() - 1] != '/')
-                findpath = RemoveFilename(findpath);
+    // Filtering directory name
+    if (!_directoryMasks.empty()) {
+        if (findpath[findpath.length() - 1] != '/')
+            findpath = RemoveFilename(findpath);
 
-            if (mask.length() > findpath.length())
-                continue;
-            // Match relative paths starting with mask
-            // -isrc matches src/foo.cpp
-            if (findpath.compare(0, mask.size(), mask) == 0)
-                return true;
-            // Match only full directory name in middle or end of the path
-            // -isrc matches myproject/src/ but does not match
-            // myproject/srcfiles/ or myproject/mysrc/
-            if (findpath.find("/" + mask) != std::string::npos)
-                return true;
-        }
-        // Filtering filename
-        else {
-            if (mask.length() > findpath.length())
-                continue;
-            // Check if path ends with mask
-            // -ifoo.cpp matches (./)foo.c, src/foo.cpp and proj/src/foo.cpp
-            // -isrc/file.cpp matches src/foo.cpp and proj/src/foo.cpp
-            if (findpath.compare(findpath.size() - mask.size(), findpath.size(), mask) == 0)
-                return true;
+        // Match relative paths starting with mask, and full directory
+        // names in the middle or end of the path.
+        // -isrc matches src/foo.cpp and myproject/src/ but does not match
+        // myproject/srcfiles/ or myproject/mysrc/
+        for (std::string::size_type start = 0; start < findpath.length();) {
+            for (std::string::size_type end = findpath.find('/', start);
+                 end != std::string::npos && end - start < _maxDirectoryMaskLength;
+                 end = findpath.find('/', end + 1)) {
+                if (_directoryMasks.find(findpath.substr(start, end + 1 - start)) != _directoryMasks.end())
+                    return true;
+            }
 
+            start = findpath.find('/', start);
+            if (start == std::string::npos)
+                break;
+            ++start;
         }
     }
+
     return false;
 }
 
@@ -19,6 +19,8 @@
 #ifndef PATHMATCH_H
 #define PATHMATCH_H
 
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -27,6 +29,10 @@
 
 /**
  * @brief Simple path matching for ignoring paths in CLI.
+ *
+ * The masks are sorted into lookup tables when the matcher is constructed,
+ * so the cost of matching a path depends on the path rather than on the
+ * number of masks.
  */
 class PathMatch {
 public:
@@ -56,7 +62,15 @@ protected:
     static std::string RemoveFilename(const std::string &path);
 
 private:
-    std::vector<std::string> _masks;
+    /** @brief Directory masks (ending with '/'). */
+    std::set<std::string> _directoryMasks;
+
+    /** @brief Length of the longest directory mask. */
+    std::string::size_type _maxDirectoryMaskLength;
+
+    /** @brief Filename masks, grouped by mask length. */
+    std::map<std::string::size_type, std::set<std::string> > _fileMasks;
+
     bool _caseSensitive;
 };
 
@@ -1,7 +1,16 @@
 #include <ctime>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
+#include <string>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 #include "cppcheck.h"
 
@@ -23,17 +32,131 @@ static void unencode(const char *src, char *dest)
 }
 
 
+#ifndef _WIN32
+/**
+ * A client of the server. Requests are:
+ *   filename\n
+ *   defines\n      (empty: check all configurations)
+ *   length\n
+ *   code           (length bytes)
+ * A request that is being checked is cancelled when the client
+ * sends "cancel\n" or closes the connection.
+ */
+class Connection {
+private:
+    const int fd;
+    std::string buffer;
+    bool closed;
+
+    bool fill() {
+        char data[4096];
+        const ssize_t len = recv(fd, data, sizeof(data), 0);
+        if (len <= 0) {
+            closed = true;
+            return false;
+        }
+        buffer.append(data, (std::size_t)len);
+        return true;
+    }
+
+public:
+    explicit Connection(int socket) : fd(socket), closed(false) {
+    }
+
+    ~Connection() {
+        close(fd);
+    }
+
+    bool readLine(std::string &line) {
+        std::string::size_type pos;
+        while ((pos = buffer.find('\n')) == std::string::npos) {
+            if (!fill())
+                return false;
+        }
+        line = buffer.substr(0, pos);
+        buffer.erase(0, pos + 1);
+        return true;
+    }
+
+    bool read(std::size_t len, std::string &data) {
+        while (buffer.size() < len) {
+            if (!fill())
+                return false;
+        }
+        data = buffer.substr(0, len);
+        buffer.erase(0, len);
+        return true;
+    }
+
+    /** has the client cancelled the current request? doesn't block */
+    bool cancelled() {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        while (!closed && poll(&pfd, 1, 0) > 0 && fill())
+            ;
+        if (buffer.compare(0, 7, "cancel\n") == 0) {
+            buffer.erase(0, 7);
+            return true;
+        }
+        return closed;
+    }
+
+    void write(const std::string &str) {
+        std::size_t pos = 0;
+        while (!closed && pos < str.size()) {
+            const ssize_t len = send(fd, str.data() + pos, str.size() - pos, MSG_NOSIGNAL);
+            if (len <= 0)
+                closed = true;
+            else
+                pos += (std::size_t)len;
+        }
+    }
+};
+#endif
+
+
 class CppcheckExecutor : public ErrorLogger {
 private:
-    const std::time_t stoptime;
+    std::time_t stoptime;
     CppCheck cppcheck;
+    std::size_t lastProgress;
+    unsigned int progressCalls;
+#ifndef _WIN32
+    Connection *connection;
+#endif
+
+    void write(const std::string &str) {
+#ifndef _WIN32
+        if (connection) {
+            connection->write(str);
+            return;
+        }
+#endif
+        printf("%s", str.c_str());
+    }
 
 public:
-    CppcheckExecutor()
+    /**
+     * @param server the instance checks many requests. The unusedFunction
+     * check is not enabled then, its data would grow with every request
+     * and it is never reported.
+     */
+    explicit CppcheckExecutor(bool server = false)
         : ErrorLogger()
         , stoptime(std::time(NULL)+2U)
-        , cppcheck(*this,false) {
-        cppcheck.settings().addEnabled("all");
+        , cppcheck(*this,false)
+        , lastProgress(0)
+        , progressCalls(0)
+#ifndef _WIN32
+        , connection(NULL)
+#endif
+    {
+        if (server)
+            cppcheck.settings().addEnabled("warning,style,performance,portability,information");
+        else
+            cppcheck.settings().addEnabled("all");
         cppcheck.settings().inconclusive = true;
     }
 
@@ -44,16 +167,50 @@ public:
         printf("\n\n");
     }
 
+#ifndef _WIN32
+    /** check the requests of a client with the warm CppCheck instance */
+    void serve(Connection &client) {
+        connection = &client;
+        std::string filename, defines, length, code;
+        while (client.readLine(filename) && client.readLine(defines) && client.readLine(length) &&
+               client.read((std::size_t)std::atol(length.c_str()), code)) {
+            stoptime = std::time(NULL) + 2U;
+            cppcheck.settings().terminate(false);
+            cppcheck.settings().userDefines = defines;
+
+            write(ErrorLogger::ErrorMessage::getXMLHeader(2) + "\n");
+            if (!code.empty())
+                cppcheck.check(filename.empty() ? std::string("test.c") : filename, code);
+            write(ErrorLogger::ErrorMessage::getXMLFooter(2) + "\n");
+        }
+        connection = NULL;
+    }
+#endif
+
     void reportOut(const std::string &outmsg) { }
     void reportErr(const ErrorLogger::ErrorMessage &msg) {
-        const std::string str(msg.toXML(true,2U));
-        printf("%s\n", str.c_str());
+        write(msg.toXML(true,2U) + "\n");
     }
 
     void reportProgress(const
                         std::string &filename,
                         const char stage[],
-                        const unsigned int value) {
+                        const std::size_t value) {
+        // Some simplifications report progress for every token. Only look
+        // at the clock and the connection when the value changes or every
+        // 1000 calls.
+        if (value == lastProgress && ++progressCalls < 1000)
+            return;
+        lastProgress = value;
+        progressCalls = 0;
+
+#ifndef _WIN32
+        if (connection) {
+            if (std::time(NULL) >= stoptime || connection->cancelled())
+                cppcheck.terminate();
+            return;
+        }
+#endif
         if (std::time(NULL) >= stoptime) {
             printf("time to analyse the "
                    "code is more than 1 "
@@ -65,8 +222,46 @@ public:
 };
 
 
-int main()
+#ifndef _WIN32
+/** Listen on a local socket and check the code that clients send */
+static int runServer(const char socketpath[])
 {
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketpath, sizeof(addr.sun_path) - 1);
+    unlink(socketpath);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 5) < 0) {
+        perror(socketpath);
+        close(fd);
+        return EXIT_FAILURE;
+    }
+
+    CppcheckExecutor cppcheckExecutor(true);
+    for (;;) {
+        const int client = accept(fd, NULL, NULL);
+        if (client < 0)
+            continue;
+        Connection connection(client);
+        cppcheckExecutor.serve(connection);
+    }
+}
+#endif
+
+
+int main(int argc, char *argv[])
+{
+#ifndef _WIN32
+    if (argc == 2 && std::strncmp(argv[1], "--server=", 9) == 0)
+        return runServer(argv[1] + 9);
+#endif
+
     char data[4096] = {0};
 
     const char *lenstr = getenv("CONTENT_LENGTH");
@@ -384,6 +384,7 @@ void MainWindow::CheckCode(const QString& code, const QString& filename)
     ClearResults();
     mUI.mResults->CheckingStarted(1);
     cppcheck.check(filename.toStdString(), code.toStdString());
+    result.FlushErrors();
     CheckDone();
 }
 
@@ -270,24 +270,25 @@ QString ResultsTree::SeverityToTranslatedString(Severity::SeverityType severity)
 }
 
 QStandardItem *ResultsTree::FindFileItem(const QString &name) const
+{
+    return mFileItems.value(FileItemKey(name), 0);
+}
+
+QString ResultsTree::FileItemKey(const QString &name)
 {
     // The first column contains the file name. In Windows we can get filenames
     // "header.h" and "Header.h" and must compare them as identical.
-
-    for (int i = 0; i < mModel.rowCount(); i++) {
 #ifdef _WIN32
-        if (QString::compare(mModel.item(i, 0)->text(), name, Qt::CaseInsensitive) == 0)
+    return name.toLower();
 #else
-        if (mModel.item(i, 0)->text() == name)
+    return name;
 #endif
-            return mModel.item(i, 0);
-    }
-    return 0;
 }
 
 void ResultsTree::Clear()
 {
     mModel.removeRows(0, mModel.rowCount());
+    mFileItems.clear();
 }
 
 void ResultsTree::Clear(const QString &filename)
@@ -302,6 +303,7 @@ void ResultsTree::Clear(const QString &filename)
         QVariantMap data = item->data().toMap();
         if (stripped == data["file"].toString() ||
             filename == data["file0"].toString()) {
+            mFileItems.remove(FileItemKey(item->text()));
             mModel.removeRow(i);
             break;
         }
@@ -422,7 +424,8 @@ void ResultsTree::RefreshTree()
             }
 
             //Hide/show accordingly
-            setRowHidden(j, file->index(), hide);
+            if (isRowHidden(j, file->index()) != hide)
+                setRowHidden(j, file->index(), hide);
 
             //If it was shown then the file itself has to be shown as well
             if (!hide) {
@@ -436,7 +439,8 @@ void ResultsTree::RefreshTree()
         }
 
         //Show the file if any of it's errors are visible
-        setRowHidden(i, QModelIndex(), !show);
+        if (isRowHidden(i, QModelIndex()) == show)
+            setRowHidden(i, QModelIndex(), !show);
     }
 }
 
@@ -462,6 +466,7 @@ QStandardItem *ResultsTree::EnsureFileItem(const QString &fullpath, const QStrin
     data["file0"] = file0;
     item->setData(QVariant(data));
     mModel.appendRow(item);
+    mFileItems[FileItemKey(name)] = item;
 
     setRowHidden(mModel.rowCount() - 1, QModelIndex(), hide);
 
@@ -1027,6 +1032,14 @@ void ResultsTree::RefreshFilePaths()
     for (int i = 0; i < mModel.rowCount(); i++) {
         RefreshFilePaths(mModel.item(i, 0));
     }
+
+    //The file items got new names
+    mFileItems.clear();
+    for (int i = 0; i < mModel.rowCount(); i++) {
+        QStandardItem *item = mModel.item(i, 0);
+        if (item)
+            mFileItems[FileItemKey(item->text())] = item;
+    }
 }
 
 bool ResultsTree::HasVisibleResults() const
@@ -20,6 +20,7 @@
 #ifndef RESULTSTREE_H
 #define RESULTSTREE_H
 
+#include <QHash>
 #include <QTreeView>
 #include <QStandardItemModel>
 #include <QStandardItem>
@@ -362,6 +363,14 @@ protected:
     */
     QStandardItem *FindFileItem(const QString &name) const;
 
+    /**
+    * @brief Key of a file item in mFileItems
+    *
+    * @param name name of the file item
+    * @return key for the file item
+    */
+    static QString FileItemKey(const QString &name);
+
 
     /**
     * @brief Ensures there's a item in the model for the specified file
@@ -386,6 +395,12 @@ protected:
     */
     QStandardItemModel mModel;
 
+    /**
+    * @brief File items in the model, by FileItemKey() of their text
+    *
+    */
+    QHash<QString, QStandardItem *> mFileItems;
+
     /**
     * @brief Program settings
     *
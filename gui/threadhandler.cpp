@@ -128,6 +128,7 @@ void ThreadHandler::ThreadDone()
 {
     mRunningThreadCount--;
     if (mRunningThreadCount == 0) {
+        mResults.FlushErrors();
         emit Done();
 
         mScanDuration = mTime.elapsed();
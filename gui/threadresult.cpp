@@ -29,7 +29,10 @@
 
 ThreadResult::ThreadResult() : mMaxProgress(0), mProgress(0), mFilesChecked(0), mTotalFiles(0)
 {
-    //ctor
+    // Emit the queued errors a few times per second
+    mFlushTimer.setInterval(200);
+    connect(&mFlushTimer, SIGNAL(timeout()), this, SLOT(FlushErrors()));
+    mFlushTimer.start();
 }
 
 ThreadResult::~ThreadResult()
@@ -59,8 +62,6 @@ void ThreadResult::FileChecked(const QString &file)
 
 void ThreadResult::reportErr(const ErrorLogger::ErrorMessage &msg)
 {
-    QMutexLocker locker(&mutex);
-
     QList<unsigned int> lines;
     QStringList files;
 
@@ -82,10 +83,26 @@ void ThreadResult::reportErr(const ErrorLogger::ErrorMessage &msg)
     item.inconclusive = msg._inconclusive;
     item.file0 = QString::fromStdString(msg.file0);
 
-    if (msg._severity != Severity::debug)
-        emit Error(item);
-    else
-        emit DebugError(item);
+    // Queue the error, it is emitted from the GUI thread by FlushErrors()
+    QMutexLocker locker(&mErrorMutex);
+    mPendingErrors << item;
+}
+
+void ThreadResult::FlushErrors()
+{
+    QList<ErrorItem> errors;
+    {
+        QMutexLocker locker(&mErrorMutex);
+        errors = mPendingErrors;
+        mPendingErrors.clear();
+    }
+
+    foreach(const ErrorItem &item, errors) {
+        if (item.severity != Severity::debug)
+            emit Error(item);
+        else
+            emit DebugError(item);
+    }
 }
 
 QString ThreadResult::GetNextFile()
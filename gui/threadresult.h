@@ -20,12 +20,13 @@
 #ifndef THREADRESULT_H
 #define THREADRESULT_H
 
+#include <QList>
 #include <QMutex>
 #include <QObject>
 #include <QStringList>
+#include <QTimer>
 #include "errorlogger.h"
-
-class ErrorItem;
+#include "erroritem.h"
 
 /// @addtogroup GUI
 /// @{
@@ -77,6 +78,13 @@ public slots:
     * @param file File that is checked
     */
     void FileChecked(const QString &file);
+
+    /**
+    * @brief Emit the errors reported since the previous call.
+    * Errors reported by the checking threads are queued and emitted in
+    * batches from the GUI thread, by a timer and when checking is done.
+    */
+    void FlushErrors();
 signals:
     /**
     * @brief Progress signal
@@ -114,6 +122,24 @@ protected:
     */
     mutable QMutex mutex;
 
+    /**
+    * @brief Mutex for the queued errors
+    *
+    */
+    QMutex mErrorMutex;
+
+    /**
+    * @brief Errors not yet emitted, see FlushErrors()
+    *
+    */
+    QList<ErrorItem> mPendingErrors;
+
+    /**
+    * @brief Timer for emitting the queued errors
+    *
+    */
+    QTimer mFlushTimer;
+
     /**
     * @brief List of files to check
     *
@@ -88,6 +88,14 @@ public:
     /** get error messages */
     virtual void getErrorMessages(ErrorLogger *errorLogger, const Settings *settings) const = 0;
 
+    /**
+     * Can this check report messages that getErrorMessages() does not
+     * list? Such checks are never skipped because of --enable.
+     */
+    virtual bool hasUnlistedMessages() const {
+        return false;
+    }
+
     /** class name, used to generate documentation */
     const std::string& name() const {
         return _name;
@@ -109,6 +117,11 @@ public:
         return _settings && _settings->inconclusive;
     }
 
+    /** @brief Has checking run out of time? Long running loops stop early then */
+    bool timedOut() const {
+        return _settings && _settings->timedOut();
+    }
+
 protected:
     const Tokenizer * const _tokenizer;
     const Settings * const _settings;
@@ -116,17 +129,20 @@ protected:
 
     /** report an error */
     void reportError(const Token *tok, const Severity::SeverityType severity, const std::string &id, const std::string &msg, bool inconclusive = false) {
-        std::list<const Token *> callstack(1, tok);
-        reportError(callstack, severity, id, msg, inconclusive);
+        const ErrorLogger::TokenMessage errmsg(tok, _tokenizer?&_tokenizer->list:0, severity, id, msg, inconclusive);
+        if (_errorLogger)
+            _errorLogger->reportTokenMessage(errmsg);
+        else
+            reportError(errmsg.toErrorMessage());
     }
 
     /** report an error */
     void reportError(const std::list<const Token *> &callstack, Severity::SeverityType severity, const std::string &id, const std::string& msg, bool inconclusive = false) {
-        ErrorLogger::ErrorMessage errmsg(callstack, _tokenizer?&_tokenizer->list:0, severity, id, msg, inconclusive);
+        const ErrorLogger::TokenMessage errmsg(callstack, _tokenizer?&_tokenizer->list:0, severity, id, msg, inconclusive);
         if (_errorLogger)
-            _errorLogger->reportErr(errmsg);
+            _errorLogger->reportTokenMessage(errmsg);
         else
-            reportError(errmsg);
+            reportError(errmsg.toErrorMessage());
     }
 
 private:
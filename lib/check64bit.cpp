@@ -44,7 +44,7 @@ static bool isint(const Variable *var)
 
 void Check64BitPortability::pointerassignment()
 {
-    if (!_settings->isEnabled("portability"))
+    if (!_settings->isEnabled(Settings::Portability))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
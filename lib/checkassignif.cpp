@@ -33,7 +33,7 @@ namespace {
 
 void CheckAssignIf::assignIf()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -164,7 +164,7 @@ void CheckAssignIf::mismatchingBitAndError(const Token *tok1, const MathLib::big
 
 void CheckAssignIf::comparison()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -214,7 +214,7 @@ void CheckAssignIf::comparisonError(const Token *tok, const std::string &bitop,
 
 void CheckAssignIf::multiCondition()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -104,7 +104,7 @@ void CheckAutoVariables::autoVariables()
 {
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    const bool reportWarnings(_settings->isEnabled("warning"));
+    const bool reportWarnings(_settings->isEnabled(Settings::Warning));
 
     const std::size_t functions = symbolDatabase->functionScopes.size();
     for (std::size_t i = 0; i < functions; ++i) {
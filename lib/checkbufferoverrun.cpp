@@ -119,7 +119,7 @@ void CheckBufferOverrun::possibleReadlinkBufferOverrunError(const Token* tok, co
 
 void CheckBufferOverrun::strncatUsageError(const Token *tok)
 {
-    if (_settings && !_settings->isEnabled("style"))
+    if (_settings && !_settings->isEnabled(Settings::Style))
         return;
 
     reportError(tok, Severity::warning, "strncatUsage",
@@ -147,7 +147,7 @@ void CheckBufferOverrun::pointerOutOfBoundsError(const Token *tok, const std::st
 
 void CheckBufferOverrun::sizeArgumentAsCharError(const Token *tok)
 {
-    if (_settings && !_settings->isEnabled("style"))
+    if (_settings && !_settings->isEnabled(Settings::Style))
         return;
     reportError(tok, Severity::warning, "sizeArgumentAsChar", "The size argument is given as a char constant.");
 }
@@ -694,7 +694,7 @@ void CheckBufferOverrun::checkFunctionParameter(const Token &tok, unsigned int p
     }
 
     // Check 'float x[10]' arguments in declaration
-    if (_settings->isEnabled("style")) {
+    if (_settings->isEnabled(Settings::Style)) {
         const Function* func = tok.function();
 
         // If argument is '%type% a[num]' then check bounds against num
@@ -1102,7 +1102,7 @@ void CheckBufferOverrun::checkScope(const Token *tok, const std::vector<std::str
         // undefined behaviour: result of pointer arithmetic is out of bounds
         else if (varid && Token::Match(tok, "= %varid% + %num% ;", varid)) {
             const MathLib::bigint index = MathLib::toLongNumber(tok->strAt(3));
-            if (index > size && _settings->isEnabled("portability"))
+            if (index > size && _settings->isEnabled(Settings::Portability))
                 pointerOutOfBoundsError(tok->next(), "buffer");
             if (index >= size && Token::Match(tok->tokAt(-2), "[;{}] %varid% =", varid))
                 pointerIsOutOfBounds = true;
@@ -1229,7 +1229,7 @@ void CheckBufferOverrun::checkScope(const Token *tok, const ArrayInfo &arrayInfo
                 unsigned int num = (unsigned int)MathLib::toLongNumber(param3->str());
 
                 // this is currently 'inconclusive'. See TestBufferOverrun::terminateStrncpy3
-                if (num >= total_size && _settings->isEnabled("style") && _settings->inconclusive) {
+                if (num >= total_size && _settings->isEnabled(Settings::Style) && _settings->inconclusive) {
                     const Token *tok2 = tok->next()->link()->next();
                     for (; tok2; tok2 = tok2->next()) {
                         if (tok2->varId() == tok->tokAt(2)->varId()) {
@@ -1303,7 +1303,7 @@ void CheckBufferOverrun::checkScope(const Token *tok, const ArrayInfo &arrayInfo
         }
 
         // undefined behaviour: result of pointer arithmetic is out of bounds
-        if (_settings->isEnabled("portability") && Token::Match(tok, "= %varid% + %num% ;", arrayInfo.varid())) {
+        if (_settings->isEnabled(Settings::Portability) && Token::Match(tok, "= %varid% + %num% ;", arrayInfo.varid())) {
             const MathLib::bigint index = MathLib::toLongNumber(tok->strAt(3));
             if (index < 0 || index > arrayInfo.num(0)) {
                 pointerOutOfBoundsError(tok->next(), "array");
@@ -2140,7 +2140,7 @@ void CheckBufferOverrun::executionPaths()
 
 void CheckBufferOverrun::arrayIndexThenCheck()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase* symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -50,7 +50,7 @@ CheckClass::CheckClass(const Tokenizer *tokenizer, const Settings *settings, Err
 
 void CheckClass::constructors()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
@@ -179,7 +179,7 @@ void CheckClass::constructors()
 
 void CheckClass::copyconstructors()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
@@ -660,7 +660,7 @@ void CheckClass::operatorEqVarError(const Token *tok, const std::string &classna
 
 void CheckClass::initializationListUsage()
 {
-    if (!_settings->isEnabled("performance"))
+    if (!_settings->isEnabled(Settings::Performance))
         return;
 
     const std::size_t functions = symbolDatabase->functionScopes.size();
@@ -746,7 +746,7 @@ static bool checkFunctionUsage(const std::string& name, const Scope* scope)
 
 void CheckClass::privateFunctions()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
@@ -854,7 +854,7 @@ void CheckClass::noMemset()
             } else if (tok->variable() && tok->variable()->type() && Token::Match(tok, "%var% = calloc|malloc|realloc|g_malloc|g_try_malloc|g_realloc|g_try_realloc (")) {
                 checkMemsetType(&(*scope), tok->tokAt(2), tok->variable()->type(), true);
 
-                if (tok->variable()->type()->numConstructors > 0 && _settings->isEnabled("warning"))
+                if (tok->variable()->type()->numConstructors > 0 && _settings->isEnabled(Settings::Warning))
                     mallocOnClassWarning(tok, tok->strAt(2), tok->variable()->type()->classDef);
             }
         }
@@ -936,7 +936,7 @@ void CheckClass::memsetError(const Token *tok, const std::string &memfunc, const
 
 void CheckClass::operatorEq()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
@@ -975,7 +975,7 @@ void CheckClass::operatorEqReturnError(const Token *tok, const std::string &clas
 
 void CheckClass::operatorEqRetRefThis()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
@@ -1071,7 +1071,7 @@ void CheckClass::operatorEqRetRefThisError(const Token *tok)
 
 void CheckClass::operatorEqToSelf()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
@@ -1311,7 +1311,7 @@ void CheckClass::virtualDestructorError(const Token *tok, const std::string &Bas
 
 void CheckClass::thisSubtraction()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const Token *tok = _tokenizer->tokens();
@@ -1342,7 +1342,7 @@ void CheckClass::checkConst()
     if (!_settings->inconclusive)
         return;
 
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
@@ -1733,7 +1733,7 @@ struct VarInfo {
 
 void CheckClass::initializerListOrder()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     // This check is not inconclusive.  However it only determines if the initialization
@@ -307,7 +307,7 @@ void CheckIO::useClosedFileError(const Token *tok)
 //---------------------------------------------------------------------------
 void CheckIO::invalidScanf()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase * const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -345,7 +345,7 @@ void CheckIO::invalidScanf()
                 else if (std::isalpha(formatstr[i]) || formatstr[i] == '[') {
                     if (formatstr[i] == 's' || formatstr[i] == '[' || formatstr[i] == 'S' || (formatstr[i] == 'l' && formatstr[i+1] == 's'))  // #3490 - field width limits are only necessary for string input
                         invalidScanfError(tok, false);
-                    else if (formatstr[i] != 'n' && formatstr[i] != 'c' && _settings->platformType != Settings::Win32A && _settings->platformType != Settings::Win32W && _settings->platformType != Settings::Win64 && _settings->isEnabled("portability"))
+                    else if (formatstr[i] != 'n' && formatstr[i] != 'c' && _settings->platformType != Settings::Win32A && _settings->platformType != Settings::Win32W && _settings->platformType != Settings::Win64 && _settings->isEnabled(Settings::Portability))
                         invalidScanfError(tok, true); // Warn about libc bug in versions prior to 2.13-25
                     format = false;
                 }
@@ -425,7 +425,7 @@ static bool isKnownType(const Variable* var, const Token* varTypeTok)
 void CheckIO::checkWrongPrintfScanfArguments()
 {
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-    bool warning = _settings->isEnabled("style");
+    bool warning = _settings->isEnabled(Settings::Style);
 
     std::size_t functions = symbolDatabase->functionScopes.size();
     for (std::size_t j = 0; j < functions; ++j) {
@@ -650,7 +650,7 @@ void CheckIO::wrongPrintfScanfArgumentsError(const Token* tok,
         unsigned int numFunction)
 {
     Severity::SeverityType severity = numFormat > numFunction ? Severity::error : Severity::warning;
-    if (severity != Severity::error && !_settings->isEnabled("style"))
+    if (severity != Severity::error && !_settings->isEnabled(Settings::Style))
         return;
 
     std::ostringstream errmsg;
@@ -742,6 +742,6 @@ void CheckIO::invalidScanfFormatWidthError(const Token* tok, unsigned int numFor
     } else
         errmsg << "Width " << width << " given in format string (no. " << numFormat << ") doesn't match destination buffer.";
 
-    if (severity == Severity::error || _settings->isEnabled("style"))
+    if (severity == Severity::error || _settings->isEnabled(Settings::Style))
         reportError(tok, severity, "invalidScanfFormatWidth", errmsg.str(), inconclusive);
 }
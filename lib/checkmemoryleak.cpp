@@ -759,7 +759,7 @@ Token *CheckMemoryLeakInFunction::getcode(const Token *tok, std::list<const Toke
     std::set<unsigned int> extravar;
 
     // The first token should be ";"
-    Token* rethead = new Token(0);
+    Token* rethead = new Token(&_codeTokens);
     rethead->str(";");
     rethead->linenr(tok->linenr());
     rethead->fileIndex(tok->fileIndex());
@@ -1467,6 +1467,10 @@ void CheckMemoryLeakInFunction::simplifycode(Token *tok) const
         //tok->printOut("simplifycode loop..");
         done = true;
 
+        // checkScope ignores the code when checking has run out of time
+        if (timedOut())
+            break;
+
         // reduce callfunc
         for (Token *tok2 = tok; tok2; tok2 = tok2->next()) {
             if (tok2->str() == "callfunc") {
@@ -2059,6 +2063,16 @@ const Token *CheckMemoryLeakInFunction::findleak(const Token *tokens)
 
 
 
+void CheckMemoryLeakInFunction::checkLimits(Token *code) const
+{
+    try {
+        _tokenizer->checkLimits();
+    } catch (const InternalError &) {
+        TokenList::deleteTokens(code);
+        throw;
+    }
+}
+
 // Check for memory leaks for a function variable.
 void CheckMemoryLeakInFunction::checkScope(const Token *Tok1, const std::string &varname, unsigned int varid, bool classmember, unsigned int sz)
 {
@@ -2071,6 +2085,7 @@ void CheckMemoryLeakInFunction::checkScope(const Token *Tok1, const std::string
 
     Token *tok = getcode(Tok1, callstack, varid, alloctype, dealloctype, classmember, sz);
     //tok->printOut((std::string("Checkmemoryleak: getcode result for: ") + varname).c_str());
+    checkLimits(tok);
 
     const bool use_addr = bool(Token::findsimplematch(tok, "&use") != NULL);
 
@@ -2111,6 +2126,7 @@ void CheckMemoryLeakInFunction::checkScope(const Token *Tok1, const std::string
     }
 
     simplifycode(tok);
+    checkLimits(tok);
 
     if (_settings->debug && _settings->_verbose) {
         tok->printOut(("Checkmemoryleak: simplifycode result for: " + varname).c_str());
@@ -2495,7 +2511,7 @@ void CheckMemoryLeakInClass::checkPublicFunctions(const Scope *scope, const Toke
     // Check that public functions deallocate the pointers that they allocate.
     // There is no checking how these functions are used and therefore it
     // isn't established if there is real leaks or not.
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const unsigned int varid = classtok->varId();
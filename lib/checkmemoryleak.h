@@ -195,6 +195,10 @@ public:
             symbolDatabase = tokenizr->getSymbolDatabase();
         else
             symbolDatabase = 0;
+
+        // the code copied by getcode counts towards the limits of the tokenizer
+        if (tokenizr)
+            _codeTokens.parent = tokenizr->list.tokensBack();
     }
 
     /** @brief run all simplified checks */
@@ -302,6 +306,13 @@ public:
     void parse_noreturn();
 
 private:
+    /**
+     * Check the limits of the tokenizer, including the code copied by getcode
+     * @param code the copied code, it is freed if a limit is exceeded
+     * @throw InternalError of type TIMEOUT or LIMIT
+     */
+    void checkLimits(Token *code) const;
+
     /** Report all possible errors (for the --errorlist) */
     void getErrorMessages(ErrorLogger *e, const Settings *settings) const {
         CheckMemoryLeakInFunction c(0, settings, e);
@@ -340,6 +351,12 @@ private:
     std::set<std::string> notnoreturn;
 
     const SymbolDatabase *symbolDatabase;
+
+    /**
+     * Counters of the tokens created by getcode. The lists of the recursive
+     * getcode calls share it, so its back is not used.
+     */
+    TokensBack _codeTokens;
 };
 
 
@@ -382,6 +399,11 @@ private:
         c.unsafeClassError(0, "class", "class::varname");
     }
 
+    /** leaks are reported with the "memleak" id that CheckMemoryLeakInFunction lists */
+    bool hasUnlistedMessages() const {
+        return true;
+    }
+
     static std::string myName() {
         return "Memory leaks (class variables)";
     }
@@ -32,7 +32,7 @@ namespace {
 
 void CheckNonReentrantFunctions::nonReentrantFunctions()
 {
-    if (!_settings->standards.posix || !_settings->isEnabled("portability"))
+    if (!_settings->standards.posix || !_settings->isEnabled(Settings::Portability))
         return;
 
     std::map<std::string,std::string>::const_iterator nonReentrant_end = _nonReentrantFunctions.end();
@@ -1099,7 +1099,7 @@ void CheckNullPointer::nullPointer()
 {
     nullPointerLinkedList();
 
-    if (_settings->isEnabled("warning")) {
+    if (_settings->isEnabled(Settings::Warning)) {
         nullPointerStructByDeRefAndChec();
         nullPointerByDeRefAndChec();
         nullPointerByCheckAndDeRef();
@@ -33,7 +33,7 @@ namespace {
 
 void CheckObsoleteFunctions::obsoleteFunctions()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -46,7 +46,7 @@ namespace {
 //----------------------------------------------------------------------------------
 void CheckOther::checkCastIntToCharAndBack()
 {
-    if (!_settings->isEnabled("warning"))
+    if (!_settings->isEnabled(Settings::Warning))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -106,7 +106,7 @@ void CheckOther::checkCastIntToCharAndBackError(const Token *tok, const std::str
 //---------------------------------------------------------------------------
 void CheckOther::checkIncrementBoolean()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -141,7 +141,7 @@ void CheckOther::incrementBooleanError(const Token *tok)
 //---------------------------------------------------------------------------
 void CheckOther::clarifyCalculation()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -222,7 +222,7 @@ void CheckOther::clarifyCalculationError(const Token *tok, const std::string &op
 //---------------------------------------------------------------------------
 void CheckOther::clarifyCondition()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const bool isC = _tokenizer->isC();
@@ -320,7 +320,7 @@ void CheckOther::clarifyConditionError(const Token *tok, bool assign, bool boolo
 //---------------------------------------------------------------------------
 void CheckOther::clarifyStatement()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -369,7 +369,7 @@ void CheckOther::clarifyStatementError(const Token *tok)
 //---------------------------------------------------------------------------
 void CheckOther::checkBitwiseOnBoolean()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     // danmar: this is inconclusive because I don't like that there are
@@ -407,7 +407,7 @@ void CheckOther::bitwiseOnBooleanError(const Token *tok, const std::string &varn
 
 void CheckOther::checkSuspiciousSemicolon()
 {
-    if (!_settings->inconclusive || !_settings->isEnabled("style"))
+    if (!_settings->inconclusive || !_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -438,7 +438,7 @@ void CheckOther::SuspiciousSemicolonError(const Token* tok)
 void CheckOther::warningOldStylePointerCast()
 {
     // Only valid on C++ code
-    if (!_settings->isEnabled("style") || !_tokenizer->isCPP())
+    if (!_settings->isEnabled(Settings::Style) || !_tokenizer->isCPP())
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -486,7 +486,7 @@ static std::string analyzeType(const Token* tok)
 
 void CheckOther::invalidPointerCast()
 {
-    if (!_settings->isEnabled("style") && !_settings->isEnabled("portability"))
+    if (!_settings->isEnabled(Settings::Style) && !_settings->isEnabled(Settings::Portability))
         return;
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -547,7 +547,7 @@ void CheckOther::invalidPointerCast()
 
             std::string fromType = analyzeType(fromTok);
             std::string toType = analyzeType(toTok);
-            if (fromType != toType && !fromType.empty() && !toType.empty() && (toType != "integer" || _settings->isEnabled("portability")) && (toTok->str() != "char" || _settings->inconclusive))
+            if (fromType != toType && !fromType.empty() && !toType.empty() && (toType != "integer" || _settings->isEnabled(Settings::Portability)) && (toTok->str() != "char" || _settings->inconclusive))
                 invalidPointerCastError(tok, fromType, toType, toTok->str() == "char");
         }
     }
@@ -568,7 +568,7 @@ void CheckOther::invalidPointerCastError(const Token* tok, const std::string& fr
 //---------------------------------------------------------------------------
 void CheckOther::checkSizeofForNumericParameter()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -604,7 +604,7 @@ void CheckOther::sizeofForNumericParameterError(const Token *tok)
 //---------------------------------------------------------------------------
 void CheckOther::checkPipeParameterSize()
 {
-    if (!_settings->isEnabled("warning")
+    if (!_settings->isEnabled(Settings::Warning)
         || !_settings->standards.posix)
         return;
 
@@ -682,7 +682,7 @@ void CheckOther::sizeofForArrayParameterError(const Token *tok)
 
 void CheckOther::checkSizeofForPointerSize()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -796,7 +796,7 @@ static void eraseNotLocalArg(std::map<unsigned int, const Token*>& container, co
 
 void CheckOther::checkRedundantAssignment()
 {
-    if (!_settings->isEnabled("performance"))
+    if (!_settings->isEnabled(Settings::Performance))
         return;
 
     const SymbolDatabase* symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -963,7 +963,7 @@ static inline bool isFunctionOrBreakPattern(const Token *tok)
 
 void CheckOther::checkRedundantAssignmentInSwitch()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -1061,7 +1061,7 @@ void CheckOther::redundantBitwiseOperationInSwitchError(const Token *tok, const
 //---------------------------------------------------------------------------
 void CheckOther::checkSwitchCaseFallThrough()
 {
-    if (!(_settings->isEnabled("style") && _settings->experimental))
+    if (!(_settings->isEnabled(Settings::Style) && _settings->experimental))
         return;
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -1196,7 +1196,7 @@ void CheckOther::switchCaseFallThrough(const Token *tok)
 //---------------------------------------------------------------------------
 void CheckOther::checkSuspiciousCaseInSwitch()
 {
-    if (!_settings->inconclusive || !_settings->isEnabled("style"))
+    if (!_settings->inconclusive || !_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -1241,7 +1241,7 @@ void CheckOther::suspiciousCaseInSwitchError(const Token* tok, const std::string
 //---------------------------------------------------------------------------
 void CheckOther::checkSuspiciousEqualityComparison()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -1314,7 +1314,7 @@ static inline const Token *findSelfAssignPattern(const Token *start)
 
 void CheckOther::checkSelfAssignment()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const Token *tok = findSelfAssignPattern(_tokenizer->tokens());
@@ -1364,7 +1364,7 @@ static inline const Token *findAssertPattern(const Token *start)
 
 void CheckOther::checkAssignmentInAssert()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const Token *tok = findAssertPattern(_tokenizer->tokens());
@@ -1457,7 +1457,7 @@ static bool analyzeLogicOperatorCondition(const Condition& c1, const Condition&
 
 void CheckOther::checkIncorrectLogicOperator()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -1772,7 +1772,7 @@ static bool isNonBoolStdType(const Variable* var)
 }
 void CheckOther::checkComparisonOfBoolWithInt()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -1853,7 +1853,7 @@ void CheckOther::comparisonOfBoolWithInvalidComparator(const Token *tok, const s
 //---------------------------------------------------------------------------
 void CheckOther::checkUnreachableCode()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -1947,7 +1947,7 @@ bool CheckOther::isSigned(const Variable* var) const
 
 void CheckOther::checkUnsignedDivision()
 {
-    bool style = _settings->isEnabled("style");
+    bool style = _settings->isEnabled(Settings::Style);
 
     const SymbolDatabase* symbolDatabase = _tokenizer->getSymbolDatabase();
     const std::size_t functions = symbolDatabase->functionScopes.size();
@@ -1995,7 +1995,7 @@ void CheckOther::udivError(const Token *tok, bool inconclusive)
 //---------------------------------------------------------------------------
 void CheckOther::checkMemsetZeroBytes()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -2024,7 +2024,7 @@ void CheckOther::memsetZeroBytesError(const Token *tok, const std::string &varna
 //---------------------------------------------------------------------------
 void CheckOther::checkVariableScope()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -2178,7 +2178,7 @@ void CheckOther::variableScopeError(const Token *tok, const std::string &varname
 //---------------------------------------------------------------------------
 void CheckOther::checkConstantFunctionParameter()
 {
-    if (!_settings->isEnabled("performance") || _tokenizer->isC())
+    if (!_settings->isEnabled(Settings::Performance) || _tokenizer->isC())
         return;
 
     const SymbolDatabase * const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -2227,7 +2227,7 @@ static bool isSignedChar(const Variable* var)
 
 void CheckOther::checkCharVariable()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -2310,7 +2310,7 @@ void CheckOther::charBitOpError(const Token *tok)
 //---------------------------------------------------------------------------
 void CheckOther::checkIncompleteStatement()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -2532,7 +2532,7 @@ void CheckOther::misusedScopeObjectError(const Token *tok, const std::string& va
 
 void CheckOther::checkComparisonOfFuncReturningBool()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     if (!_tokenizer->isCPP())
@@ -2612,7 +2612,7 @@ void CheckOther::checkComparisonOfBoolWithBool()
     if (!_settings->experimental)
         return;
 
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     if (!_tokenizer->isCPP())
@@ -2661,7 +2661,7 @@ void CheckOther::comparisonOfBoolWithBoolError(const Token *tok, const std::stri
 //---------------------------------------------------------------------------
 void CheckOther::checkIncorrectStringCompare()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -2733,7 +2733,7 @@ static bool expressionHasSideEffects(const Token *first, const Token *last)
 
 void CheckOther::checkDuplicateIf()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -2802,7 +2802,7 @@ void CheckOther::duplicateIfError(const Token *tok1, const Token *tok2)
 //-----------------------------------------------------------------------------
 void CheckOther::checkDuplicateBranch()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -3293,7 +3293,7 @@ void CheckOther::complexDuplicateExpressionCheck(const std::list<const Function*
 //---------------------------------------------------------------------------
 void CheckOther::checkDuplicateExpression()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     // Parse all executing scopes..
@@ -3364,7 +3364,7 @@ void CheckOther::duplicateExpressionError(const Token *tok1, const Token *tok2,
 //---------------------------------------------------------------------------
 void CheckOther::checkAlwaysTrueOrFalseStringCompare()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const Token *tok = _tokenizer->tokens();
@@ -3426,7 +3426,7 @@ void CheckOther::alwaysTrueStringVariableCompareError(const Token *tok, const st
 //-----------------------------------------------------------------------------
 void CheckOther::checkSuspiciousStringCompare()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase* symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -3493,7 +3493,7 @@ void CheckOther::moduloAlwaysTrueFalseError(const Token* tok, const std::string&
 //-----------------------------------------------------------------------------
 void CheckOther::sizeofsizeof()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
         if (Token::Match(tok, "sizeof (| sizeof")) {
@@ -3516,7 +3516,7 @@ void CheckOther::sizeofsizeofError(const Token *tok)
 //-----------------------------------------------------------------------------
 void CheckOther::sizeofCalculation()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -3549,7 +3549,7 @@ void CheckOther::sizeofCalculationError(const Token *tok, bool inconclusive)
 //-----------------------------------------------------------------------------
 void CheckOther::redundantGetAndSetUserId()
 {
-    if (_settings->isEnabled("warning")
+    if (_settings->isEnabled(Settings::Warning)
         && _settings->standards.posix) {
 
         for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -3575,7 +3575,7 @@ void CheckOther::redundantGetAndSetUserIdError(const Token *tok)
 //-----------------------------------------------------------------------------
 void CheckOther::suspiciousSizeofCalculation()
 {
-    if (!_settings->isEnabled("style") || !_settings->inconclusive)
+    if (!_settings->isEnabled(Settings::Style) || !_settings->inconclusive)
         return;
 
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -3635,7 +3635,7 @@ void CheckOther::assignBoolToPointerError(const Token *tok)
 //-----------------------------------------------------------------------------
 void CheckOther::checkComparisonOfBoolExpressionWithInt()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase* symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -3704,7 +3704,7 @@ void CheckOther::comparisonOfBoolExpressionWithIntError(const Token *tok, bool n
 //---------------------------------------------------------------------------
 void CheckOther::checkSignOfUnsignedVariable()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const bool inconclusive = _tokenizer->codeWithTemplates();
@@ -3796,7 +3796,7 @@ In most scenarios, "const A & a = getA()" will be more efficient.
 */
 void CheckOther::checkRedundantCopy()
 {
-    if (!_settings->isEnabled("performance") || _tokenizer->isC())
+    if (!_settings->isEnabled(Settings::Performance) || _tokenizer->isC())
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -3879,7 +3879,7 @@ void CheckOther::negativeBitwiseShiftError(const Token *tok)
 //---------------------------------------------------------------------------
 void CheckOther::checkIncompleteArrayFill()
 {
-    if (!_settings->inconclusive || !_settings->isEnabled("style"))
+    if (!_settings->inconclusive || !_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -3897,7 +3897,7 @@ void CheckOther::checkIncompleteArrayFill()
                     unsigned int size = _tokenizer->sizeOfType(var->typeStartToken());
                     if ((size != 1 && size != 100 && size != 0) || var->typeEndToken()->str() == "*")
                         incompleteArrayFillError(tok, var->name(), tok->str(), false);
-                    else if (var->typeStartToken()->str() == "bool" && _settings->isEnabled("portability")) // sizeof(bool) is not 1 on all platforms
+                    else if (var->typeStartToken()->str() == "bool" && _settings->isEnabled(Settings::Portability)) // sizeof(bool) is not 1 on all platforms
                         incompleteArrayFillError(tok, var->name(), tok->str(), true);
                 }
             }
@@ -3921,7 +3921,7 @@ void CheckOther::incompleteArrayFillError(const Token* tok, const std::string& b
 void CheckOther::oppositeInnerCondition()
 {
     // FIXME: This check is experimental because of #4170 and #4186. Fix those tickets and remove the "experimental".
-    if (!_settings->isEnabled("style") || !_settings->inconclusive || !_settings->experimental)
+    if (!_settings->isEnabled(Settings::Style) || !_settings->inconclusive || !_settings->experimental)
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -3988,7 +3988,7 @@ void CheckOther::oppositeInnerConditionError(const Token *tok)
 
 void CheckOther::checkVarFuncNullUB()
 {
-    if (!_settings->isEnabled("portability"))
+    if (!_settings->isEnabled(Settings::Portability))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
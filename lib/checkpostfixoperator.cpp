@@ -34,7 +34,7 @@ namespace {
 
 void CheckPostfixOperator::postfixOperator()
 {
-    if (!_settings->isEnabled("performance"))
+    if (!_settings->isEnabled(Settings::Performance))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
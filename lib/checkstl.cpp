@@ -774,7 +774,7 @@ static bool if_findCompare(const Token * const tokBack, bool str)
 
 void CheckStl::if_find()
 {
-    if (!_settings->isEnabled("style"))
+    if (!_settings->isEnabled(Settings::Style))
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -924,7 +924,7 @@ static bool isContainerSizeSlow(const Token *tok)
 
 void CheckStl::size()
 {
-    if (!_settings->isEnabled("performance"))
+    if (!_settings->isEnabled(Settings::Performance))
         return;
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
@@ -1107,7 +1107,7 @@ void CheckStl::string_c_str()
 
     // Find all functions that take std::string as argument
     std::multimap<std::string, unsigned int> c_strFuncParam;
-    if (_settings->isEnabled("performance")) {
+    if (_settings->isEnabled(Settings::Performance)) {
         for (std::list<Scope>::const_iterator scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
             for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                 if (c_strFuncParam.erase(func->tokenDef->str()) != 0) { // Check if function with this name was already found
@@ -1154,7 +1154,7 @@ void CheckStl::string_c_str()
                 if (var && var->isPointer())
                     string_c_strError(tok);
             } else if (Token::Match(tok, "%var% ( !!)") && c_strFuncParam.find(tok->str()) != c_strFuncParam.end() &&
-                       _settings->isEnabled("performance") && !Token::Match(tok->previous(), "::|.") && tok->varId() == 0 && tok->str() != scope->className) { // calling function. TODO: Add support for member functions
+                       _settings->isEnabled(Settings::Performance) && !Token::Match(tok->previous(), "::|.") && tok->varId() == 0 && tok->str() != scope->className) { // calling function. TODO: Add support for member functions
                 std::pair<std::multimap<std::string, unsigned int>::const_iterator, std::multimap<std::string, unsigned int>::const_iterator> range = c_strFuncParam.equal_range(tok->str());
                 for (std::multimap<std::string, unsigned int>::const_iterator i = range.first; i != range.second; ++i) {
                     if (i->second == 0)
@@ -1213,7 +1213,7 @@ void CheckStl::string_c_str()
                 }
             }
             // Using c_str() to get the return value is redundant if the function returns std::string or const std::string&.
-            else if ((returnType == stdString || returnType == stdStringConstRef) && _settings->isEnabled("performance")) {
+            else if ((returnType == stdString || returnType == stdStringConstRef) && _settings->isEnabled(Settings::Performance)) {
                 if (tok->str() == "return") {
                     const Token* tok2 = Token::findsimplematch(tok->next(), ";");
                     if (Token::simpleMatch(tok2->tokAt(-4), ". c_str ( )")) {
@@ -1318,7 +1318,7 @@ void CheckStl::checkAutoPointer()
             }
         } else {
             if (Token::Match(tok, "%var% = %var% ;")) {
-                if (_settings->isEnabled("style")) {
+                if (_settings->isEnabled(Settings::Style)) {
                     std::set<unsigned int>::const_iterator iter = autoPtrVarId.find(tok->tokAt(2)->varId());
                     if (iter != autoPtrVarId.end()) {
                         autoPointerError(tok->tokAt(2));
@@ -1362,8 +1362,8 @@ void CheckStl::autoPointerArrayError(const Token *tok)
 
 void CheckStl::uselessCalls()
 {
-    bool performance = _settings->isEnabled("performance");
-    bool style = _settings->isEnabled("style");
+    bool performance = _settings->isEnabled(Settings::Performance);
+    bool style = _settings->isEnabled(Settings::Style);
     if (!performance && !style)
         return;
 
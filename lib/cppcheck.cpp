@@ -25,8 +25,10 @@
 
 #include <algorithm>
 #include <fstream>
+#include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 #include "timer.h"
 
 #ifdef HAVE_RULES
@@ -39,8 +41,53 @@ static const char ExtraVersion[] = "";
 
 static TimerResults S_timerResults;
 
+namespace {
+    /** @brief Collects the severities of the messages that a checker can report */
+    class SeverityCollector : public ErrorLogger {
+    public:
+        std::set<Severity::SeverityType> severities;
+
+        void reportOut(const std::string &) { }
+        void reportErr(const ErrorLogger::ErrorMessage &msg) {
+            severities.insert(msg._severity);
+        }
+    };
+
+    /** @brief Reports the token and memory usage of a configuration with --showtime */
+    class MemoryCounters {
+    public:
+        MemoryCounters(const Tokenizer &tokenizer, unsigned int showtimeMode, TimerResultsIntf *timerResults)
+            : _tokenizer(tokenizer), _showtimeMode(showtimeMode), _timerResults(timerResults) {
+        }
+
+        ~MemoryCounters() {
+            if (_showtimeMode == SHOWTIME_NONE)
+                return;
+            report("Tokenizer::tokensAllocated", _tokenizer.allocatedTokenCount(), false);
+            report("Tokenizer::peakTokens", _tokenizer.peakTokenCount(), true);
+            report("Tokenizer::peakTokenBytes", _tokenizer.peakTokenCount() * sizeof(Token), true);
+            report("SymbolDatabase::peakBytes", _tokenizer.peakSymbolDatabaseSize(), true);
+            report("Tokenizer::estimatedPeakBytes", _tokenizer.estimatedMemoryUsage(), true);
+        }
+
+    private:
+        void report(const std::string &str, std::size_t value, bool maximum) const {
+            if (_showtimeMode == SHOWTIME_FILE)
+                std::cout << str << ": " << value << std::endl;
+            else if (_timerResults && maximum)
+                _timerResults->AddMaximum(str, (unsigned long)value);
+            else if (_timerResults)
+                _timerResults->AddCount(str, (unsigned long)value);
+        }
+
+        const Tokenizer &_tokenizer;
+        const unsigned int _showtimeMode;
+        TimerResultsIntf *_timerResults;
+    };
+}
+
 CppCheck::CppCheck(ErrorLogger &errorLogger, bool useGlobalSuppressions)
-    : _errorLogger(errorLogger), exitcode(0), _useGlobalSuppressions(useGlobalSuppressions), tooManyConfigs(false)
+    : _checkersPlanned(false), _plannedEnabled(0), _errorLogger(errorLogger), exitcode(0), _useGlobalSuppressions(useGlobalSuppressions), tooManyConfigs(false)
 {
 }
 
@@ -48,6 +95,9 @@ CppCheck::~CppCheck()
 {
     if (_settings._showtime != SHOWTIME_NONE)
         S_timerResults.ShowResults();
+#ifdef HAVE_RULES
+    freeRules();
+#endif
 }
 
 const char * CppCheck::version()
@@ -104,6 +154,7 @@ bool CppCheck::findError(std::string code, const char FileName[])
             // is still there.
             code = previousCode.substr(found+9);
             _errorList.clear();
+            _errorSet.clear();
             checkFile(code, FileName);
         }
 
@@ -146,6 +197,9 @@ unsigned int CppCheck::processFile(const std::string& filename)
         _errorLogger.reportOut(std::string("Checking ") + fixedpath + std::string("..."));
     }
 
+    planCheckers();
+    _settings.startFileTimer();
+
     try {
         Preprocessor preprocessor(&_settings, this);
         std::list<std::string> configurations;
@@ -172,7 +226,7 @@ unsigned int CppCheck::processFile(const std::string& filename)
         }
 
         if (!_settings._force && configurations.size() > _settings._maxConfigs) {
-            if (_settings.isEnabled("information")) {
+            if (_settings.isEnabled(Settings::Information)) {
                 tooManyConfigsError(Path::toNativeSeparators(filename),configurations.size());
             } else {
                 tooManyConfigs = true;
@@ -206,7 +260,12 @@ unsigned int CppCheck::processFile(const std::string& filename)
                     return exitcode;
                 }
             } else {
+                _settings.startConfigTimer();
                 checkFile(codeWithoutCfg + appendCode, filename.c_str());
+
+                // checkFile has reported it if the file ran out of time
+                if (_settings.fileTimedOut())
+                    break;
             }
         }
     } catch (const std::runtime_error &e) {
@@ -219,6 +278,7 @@ unsigned int CppCheck::processFile(const std::string& filename)
         reportUnmatchedSuppressions(_settings.nomsg.getUnmatchedLocalSuppressions(filename));
 
     _errorList.clear();
+    _errorSet.clear();
     return exitcode;
 }
 
@@ -227,7 +287,7 @@ unsigned int CppCheck::processFile(const std::string& filename)
 void CppCheck::checkFunctionUsage()
 {
     // This generates false positives - especially for libraries
-    if (_settings.isEnabled("unusedFunction") && _settings._jobs == 1) {
+    if (_settings.isEnabled(Settings::UnusedFunction) && _settings._jobs == 1) {
         const bool verbose_orig = _settings._verbose;
         _settings._verbose = false;
 
@@ -255,8 +315,7 @@ void CppCheck::analyseFile(std::istream &fin, const std::string &filename)
 
     // Tokenize..
     Tokenizer tokenizer(&_settings, this);
-    std::istringstream istr(code);
-    tokenizer.tokenize(istr, filename.c_str(), "");
+    tokenizer.tokenize(code, filename.c_str(), "");
     tokenizer.simplifyTokenList();
 
     // Analyse the tokens..
@@ -273,6 +332,59 @@ void CppCheck::analyseFile(std::istream &fin, const std::string &filename)
     }
 }
 
+void CppCheck::planCheckers()
+{
+    // The plan only depends on the enabled severities
+    unsigned int enabled = 0;
+    const Settings::EnabledCheck categories[] = { Settings::Warning, Settings::Style, Settings::Performance, Settings::Portability, Settings::Information };
+    for (std::size_t i = 0; i < sizeof(categories) / sizeof(categories[0]); ++i) {
+        if (_settings.isEnabled(categories[i]))
+            enabled |= categories[i];
+    }
+    if (_checkersPlanned && enabled == _plannedEnabled)
+        return;
+    _checkersPlanned = true;
+    _plannedEnabled = enabled;
+
+    _skippedCheckers.clear();
+
+    for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
+        if ((*it)->hasUnlistedMessages())
+            continue;
+
+        SeverityCollector collector;
+        (*it)->getErrorMessages(&collector, &_settings);
+        if (collector.severities.empty())
+            continue;
+
+        bool skip = true;
+        for (std::set<Severity::SeverityType>::const_iterator sev = collector.severities.begin(); skip && sev != collector.severities.end(); ++sev) {
+            switch (*sev) {
+            case Severity::warning:
+                skip = !_settings.isEnabled(Settings::Warning);
+                break;
+            case Severity::style:
+                skip = !_settings.isEnabled(Settings::Style);
+                break;
+            case Severity::performance:
+                skip = !_settings.isEnabled(Settings::Performance);
+                break;
+            case Severity::portability:
+                skip = !_settings.isEnabled(Settings::Portability);
+                break;
+            case Severity::information:
+                skip = !_settings.isEnabled(Settings::Information);
+                break;
+            default:
+                skip = false;
+                break;
+            }
+        }
+        if (skip)
+            _skippedCheckers.insert(*it);
+    }
+}
+
 //---------------------------------------------------------------------------
 // CppCheck - A function that checks a specified file
 //---------------------------------------------------------------------------
@@ -285,14 +397,13 @@ void CppCheck::checkFile(const std::string &code, const char FileName[])
     Tokenizer _tokenizer(&_settings, this);
     if (_settings._showtime != SHOWTIME_NONE)
         _tokenizer.setTimerResults(&S_timerResults);
+    const MemoryCounters memoryCounters(_tokenizer, _settings._showtime, &S_timerResults);
     try {
         bool result;
 
         // Tokenize the file
-        std::istringstream istr(code);
-
         Timer timer("Tokenizer::tokenize", _settings._showtime, &S_timerResults);
-        result = _tokenizer.tokenize(istr, FileName, cfg);
+        result = _tokenizer.tokenize(code, FileName, cfg);
         timer.Stop();
         if (!result) {
             // File had syntax errors, abort
@@ -307,12 +418,15 @@ void CppCheck::checkFile(const std::string &code, const char FileName[])
         for (std::list<Check *>::iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
             if (_settings.terminated())
                 return;
+            if (_skippedCheckers.find(*it) != _skippedCheckers.end())
+                continue;
+            _tokenizer.checkLimits();
 
             Timer timerRunChecks((*it)->name() + "::runChecks", _settings._showtime, &S_timerResults);
             (*it)->runChecks(&_tokenizer, &_settings, this);
         }
 
-        if (_settings.isEnabled("unusedFunction") && _settings._jobs == 1)
+        if (_settings.isEnabled(Settings::UnusedFunction) && _settings._jobs == 1)
             _checkUnusedFunctions.parseTokens(_tokenizer);
 
         Timer timer3("Tokenizer::simplifyTokenList", _settings._showtime, &S_timerResults);
@@ -325,80 +439,20 @@ void CppCheck::checkFile(const std::string &code, const char FileName[])
         for (std::list<Check *>::iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
             if (_settings.terminated())
                 return;
+            if (_skippedCheckers.find(*it) != _skippedCheckers.end())
+                continue;
+            _tokenizer.checkLimits();
 
             Timer timerSimpleChecks((*it)->name() + "::runSimplifiedChecks", _settings._showtime, &S_timerResults);
             (*it)->runSimplifiedChecks(&_tokenizer, &_settings, this);
         }
 
 #ifdef HAVE_RULES
-        // Are there extra rules?
-        if (!_settings.rules.empty()) {
-            std::ostringstream ostr;
-            for (const Token *tok = _tokenizer.tokens(); tok; tok = tok->next())
-                ostr << " " << tok->str();
-            const std::string str(ostr.str());
-            for (std::list<Settings::Rule>::const_iterator it = _settings.rules.begin(); it != _settings.rules.end(); ++it) {
-                const Settings::Rule &rule = *it;
-                if (rule.pattern.empty() || rule.id.empty() || rule.severity.empty())
-                    continue;
-
-                const char *error = 0;
-                int erroffset = 0;
-                pcre *re = pcre_compile(rule.pattern.c_str(),0,&error,&erroffset,NULL);
-                if (!re && error) {
-                    ErrorLogger::ErrorMessage errmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
-                                                     Severity::error,
-                                                     error,
-                                                     "pcre_compile",
-                                                     false);
-
-                    reportErr(errmsg);
-                }
-                if (!re)
-                    continue;
-
-                int pos = 0;
-                int ovector[30];
-                while (0 <= pcre_exec(re, NULL, str.c_str(), (int)str.size(), pos, 0, ovector, 30)) {
-                    unsigned int pos1 = (unsigned int)ovector[0];
-                    unsigned int pos2 = (unsigned int)ovector[1];
-
-                    // jump to the end of the match for the next pcre_exec
-                    pos = (int)pos2;
-
-                    // determine location..
-                    ErrorLogger::ErrorMessage::FileLocation loc;
-                    loc.setfile(_tokenizer.getSourceFilePath());
-                    loc.line = 0;
-
-                    unsigned int len = 0;
-                    for (const Token *tok = _tokenizer.tokens(); tok; tok = tok->next()) {
-                        len = len + 1 + tok->str().size();
-                        if (len > pos1) {
-                            loc.setfile(_tokenizer.list.getFiles().at(tok->fileIndex()));
-                            loc.line = tok->linenr();
-                            break;
-                        }
-                    }
-
-                    const std::list<ErrorLogger::ErrorMessage::FileLocation> callStack(1, loc);
-
-                    // Create error message
-                    std::string summary;
-                    if (rule.summary.empty())
-                        summary = "found '" + str.substr(pos1, pos2 - pos1) + "'";
-                    else
-                        summary = rule.summary;
-                    const ErrorLogger::ErrorMessage errmsg(callStack, Severity::fromString(rule.severity), summary, rule.id, false);
-
-                    // Report error
-                    reportErr(errmsg);
-                }
-
-                pcre_free(re);
-            }
-        }
+        executeRules(_tokenizer);
 #endif
+
+        // report it if the time ran out during the last checker
+        _tokenizer.checkLimits();
     } catch (const InternalError &e) {
         std::list<ErrorLogger::ErrorMessage::FileLocation> locationList;
         ErrorLogger::ErrorMessage::FileLocation loc2;
@@ -413,16 +467,185 @@ void CppCheck::checkFile(const std::string &code, const char FileName[])
             loc.setfile(_tokenizer.getSourceFilePath());
         }
         locationList.push_back(loc);
+        // An exceeded limit was asked for, so it is not reported as an error
+        std::string id("cppcheckError");
+        if (e.type == InternalError::LIMIT)
+            id = "resourceLimit";
+        else if (e.type == InternalError::TIMEOUT)
+            id = "timeout";
         const ErrorLogger::ErrorMessage errmsg(locationList,
-                                               Severity::error,
+                                               e.type == InternalError::INTERNAL ? Severity::error : Severity::information,
                                                e.errorMessage,
-                                               "cppcheckError",
+                                               id,
                                                false);
 
         _errorLogger.reportErr(errmsg);
     }
 }
 
+#ifdef HAVE_RULES
+struct CppCheck::CompiledRule {
+    Settings::Rule rule;
+    pcre *re;
+    pcre_extra *extra;
+};
+
+static bool sameRule(const Settings::Rule &rule1, const Settings::Rule &rule2)
+{
+    return rule1.pattern == rule2.pattern &&
+           rule1.id == rule2.id &&
+           rule1.severity == rule2.severity &&
+           rule1.summary == rule2.summary;
+}
+
+static bool sameRules(const std::list<Settings::Rule> &rules1, const std::list<Settings::Rule> &rules2)
+{
+    if (rules1.size() != rules2.size())
+        return false;
+    return std::equal(rules1.begin(), rules1.end(), rules2.begin(), sameRule);
+}
+
+void CppCheck::compileRules()
+{
+    freeRules();
+    _compiledRulesSource = _settings.rules;
+
+    for (std::list<Settings::Rule>::const_iterator it = _settings.rules.begin(); it != _settings.rules.end(); ++it) {
+        const Settings::Rule &rule = *it;
+        if (rule.pattern.empty() || rule.id.empty() || rule.severity.empty())
+            continue;
+
+        const char *error = 0;
+        int erroffset = 0;
+        pcre *re = pcre_compile(rule.pattern.c_str(),0,&error,&erroffset,NULL);
+        if (!re) {
+            if (error) {
+                ErrorLogger::ErrorMessage errmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
+                                                 Severity::error,
+                                                 error,
+                                                 "pcre_compile",
+                                                 false);
+
+                reportErr(errmsg);
+            }
+            continue;
+        }
+
+        // The pattern is matched against every file, study it (and use
+        // the JIT compiler if it is available)
+        int studyOptions = 0;
+#ifdef PCRE_STUDY_JIT_COMPILE
+        studyOptions |= PCRE_STUDY_JIT_COMPILE;
+#endif
+        error = 0;
+        pcre_extra *extra = pcre_study(re, studyOptions, &error);
+
+        CompiledRule *compiledRule = new CompiledRule;
+        compiledRule->rule = rule;
+        compiledRule->re = re;
+        compiledRule->extra = extra;
+        _compiledRules.push_back(compiledRule);
+    }
+}
+
+void CppCheck::freeRules()
+{
+    for (std::list<CompiledRule *>::iterator it = _compiledRules.begin(); it != _compiledRules.end(); ++it) {
+        if ((*it)->extra) {
+#ifdef PCRE_STUDY_JIT_COMPILE
+            pcre_free_study((*it)->extra);
+#else
+            pcre_free((*it)->extra);
+#endif
+        }
+        pcre_free((*it)->re);
+        delete *it;
+    }
+    _compiledRules.clear();
+    _compiledRulesSource.clear();
+}
+
+void CppCheck::executeRules(const Tokenizer &tokenizer)
+{
+    // Are there extra rules?
+    if (_settings.rules.empty())
+        return;
+
+    // The settings can be replaced between checks, for example by the GUI
+    if (!sameRules(_settings.rules, _compiledRulesSource))
+        compileRules();
+    if (_compiledRules.empty())
+        return;
+
+    // Write all tokens in a string that can be matched, and remember
+    // where each token ends in that string
+    std::string str;
+    std::vector<const Token *> tokens;
+    std::vector<std::string::size_type> tokenEnds;
+    for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+        str += " ";
+        str += tok->str();
+        tokens.push_back(tok);
+        tokenEnds.push_back(str.size());
+    }
+
+    for (std::list<CompiledRule *>::const_iterator it = _compiledRules.begin(); it != _compiledRules.end(); ++it) {
+        const CompiledRule &compiledRule = **it;
+        const Settings::Rule &rule = compiledRule.rule;
+
+        Timer timerRule("Rule " + rule.id, _settings._showtime, &S_timerResults);
+
+        unsigned long matches = 0;
+        int pos = 0;
+        int ovector[30];
+        while (pos <= (int)str.size() && 0 <= pcre_exec(compiledRule.re, compiledRule.extra, str.c_str(), (int)str.size(), pos, 0, ovector, 30)) {
+            unsigned int pos1 = (unsigned int)ovector[0];
+            unsigned int pos2 = (unsigned int)ovector[1];
+
+            // jump to the end of the match for the next pcre_exec
+            // (don't match an empty string at the same position again)
+            pos = (pos2 > pos1) ? (int)pos2 : (int)pos2 + 1;
+
+            ++matches;
+
+            // determine location..
+            ErrorLogger::ErrorMessage::FileLocation loc;
+            loc.setfile(tokenizer.getSourceFilePath());
+            loc.line = 0;
+
+            const std::vector<std::string::size_type>::const_iterator tokenEnd = std::upper_bound(tokenEnds.begin(), tokenEnds.end(), pos1);
+            if (tokenEnd != tokenEnds.end()) {
+                const Token *tok = tokens[tokenEnd - tokenEnds.begin()];
+                loc.setfile(tokenizer.list.getFiles().at(tok->fileIndex()));
+                loc.line = tok->linenr();
+            }
+
+            const std::list<ErrorLogger::ErrorMessage::FileLocation> callStack(1, loc);
+
+            // Create error message
+            std::string summary;
+            if (rule.summary.empty())
+                summary = "found '" + str.substr(pos1, pos2 - pos1) + "'";
+            else
+                summary = rule.summary;
+            const ErrorLogger::ErrorMessage errmsg(callStack, Severity::fromString(rule.severity), summary, rule.id, false);
+
+            // Report error
+            reportErr(errmsg);
+        }
+
+        timerRule.Stop();
+        if (_settings._showtime == SHOWTIME_FILE) {
+            std::ostringstream ostr;
+            ostr << "Rule " << rule.id << ": " << matches << " match(es)";
+            _errorLogger.reportOut(ostr.str());
+        } else if (_settings._showtime != SHOWTIME_NONE) {
+            S_timerResults.AddCount("Rule " + rule.id + "::matches", matches);
+        }
+    }
+}
+#endif
+
 Settings &CppCheck::settings()
 {
     return _settings;
@@ -430,12 +653,12 @@ Settings &CppCheck::settings()
 
 void CppCheck::tooManyConfigsError(const std::string &file, const std::size_t numberOfConfigurations)
 {
-    if (!_settings.isEnabled("information") && !tooManyConfigs)
+    if (!_settings.isEnabled(Settings::Information) && !tooManyConfigs)
         return;
 
     tooManyConfigs = false;
 
-    if (_settings.isEnabled("information") && file.empty())
+    if (_settings.isEnabled(Settings::Information) && file.empty())
         return;
 
     std::list<ErrorLogger::ErrorMessage::FileLocation> loclist;
@@ -472,41 +695,58 @@ void CppCheck::tooManyConfigsError(const std::string &file, const std::size_t nu
 
 void CppCheck::reportErr(const ErrorLogger::ErrorMessage &msg)
 {
+    std::string file;
+    unsigned int line(0);
+    if (!msg._callStack.empty()) {
+        file = msg._callStack.back().getfile(false);
+        line = msg._callStack.back().line;
+    }
+
+    // Check suppressions before the message is formatted, suppressed
+    // messages are common and formatting is expensive.
+    if (isSuppressed(msg._id, file, line))
+        return;
+
     std::string errmsg = msg.toString(_settings._verbose);
     if (errmsg.empty())
         return;
 
     // Alert only about unique errors
-    if (std::find(_errorList.begin(), _errorList.end(), errmsg) != _errorList.end())
+    if (!_errorSet.insert(errmsg).second)
         return;
 
+    _errorList.push_back(errmsg);
+
     if (_settings.debugFalsePositive) {
         // Don't print out error
-        _errorList.push_back(errmsg);
         return;
     }
 
-    std::string file;
-    unsigned int line(0);
-    if (!msg._callStack.empty()) {
-        file = msg._callStack.back().getfile(false);
-        line = msg._callStack.back().line;
-    }
+    if (!_settings.nofail.isSuppressed(msg._id, file, line))
+        exitcode = 1;
 
-    if (_useGlobalSuppressions) {
-        if (_settings.nomsg.isSuppressed(msg._id, file, line))
-            return;
-    } else {
-        if (_settings.nomsg.isSuppressedLocal(msg._id, file, line))
+    _errorLogger.reportErr(msg);
+}
+
+void CppCheck::reportTokenMessage(const ErrorLogger::TokenMessage &msg)
+{
+    // Suppressed messages are dropped before they are converted
+    if (msg.size() > 0) {
+        const ErrorLogger::TokenMessage::Location &loc = msg.location(msg.size() - 1);
+        if (isSuppressed(msg.id(), msg.file(loc), loc.line))
             return;
     }
 
-    if (!_settings.nofail.isSuppressed(msg._id, file, line))
-        exitcode = 1;
-
-    _errorList.push_back(errmsg);
+    reportErr(msg.toErrorMessage());
+}
 
-    _errorLogger.reportErr(msg);
+bool CppCheck::isSuppressed(const std::string &id, const std::string &file, unsigned int line)
+{
+    if (_settings.debugFalsePositive)
+        return false;
+    if (_useGlobalSuppressions)
+        return _settings.nomsg.isSuppressed(id, file, line);
+    return _settings.nomsg.isSuppressedLocal(id, file, line);
 }
 
 void CppCheck::reportOut(const std::string &outmsg)
@@ -549,6 +789,20 @@ void CppCheck::getErrorMessages()
     tooManyConfigs = true;
     tooManyConfigsError("",0U);
 
+    const ErrorLogger::ErrorMessage limitmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
+                                             Severity::information,
+                                             "Checking of this configuration was aborted because it needed more than the allowed number of tokens or memory.",
+                                             "resourceLimit",
+                                             false);
+    reportErr(limitmsg);
+
+    const ErrorLogger::ErrorMessage timeoutmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
+                                               Severity::information,
+                                               "Checking of this file was aborted because it took more than the allowed time.",
+                                               "timeout",
+                                               false);
+    reportErr(timeoutmsg);
+
     // call all "getErrorMessages" in all registered Check classes
     for (std::list<Check *>::iterator it = Check::instances().begin(); it != Check::instances().end(); ++it)
         (*it)->getErrorMessages(this, &_settings);
@@ -26,8 +26,12 @@
 
 #include <string>
 #include <list>
+#include <set>
 #include <istream>
 
+class Tokenizer;
+class Check;
+
 /// @addtogroup Core
 /// @{
 
@@ -141,6 +145,48 @@ private:
     /** @brief Check file */
     void checkFile(const std::string &code, const char FileName[]);
 
+    /**
+     * @brief Determine which registered checkers can be skipped.
+     * A checker is skipped when every message it lists in
+     * getErrorMessages() has a severity whose --enable category is
+     * not enabled. Checkers that can report errors are never skipped.
+     * The plan is made again only when the enabled severities change.
+     */
+    void planCheckers();
+
+    /** @brief Checkers that checkFile() skips, see planCheckers() */
+    std::set<const Check *> _skippedCheckers;
+
+    /** @brief Has planCheckers() made a plan? */
+    bool _checkersPlanned;
+
+    /** @brief The enabled severities that _skippedCheckers was planned for */
+    unsigned int _plannedEnabled;
+
+#ifdef HAVE_RULES
+    /** @brief A rule with its compiled pattern. It is defined in
+        cppcheck.cpp, so that including this header needs no pcre.h */
+    struct CompiledRule;
+
+    /** @brief Compiled rules, see compileRules() */
+    std::list<CompiledRule *> _compiledRules;
+
+    /** @brief The rules that _compiledRules were compiled from */
+    std::list<Settings::Rule> _compiledRulesSource;
+
+    /**
+     * @brief Compile the patterns in Settings::rules. They are compiled
+     * again only when the rules in the settings are changed.
+     */
+    void compileRules();
+
+    /** @brief Free the compiled rules */
+    void freeRules();
+
+    /** @brief Run the rules on the simplified token list */
+    void executeRules(const Tokenizer &tokenizer);
+#endif
+
     /**
      * @brief Errors and warnings are directed here.
      *
@@ -150,6 +196,15 @@ private:
      */
     virtual void reportErr(const ErrorLogger::ErrorMessage &msg);
 
+    /**
+     * @brief Errors found by the checks are directed here. Suppressed
+     * messages are dropped before they are converted to an ErrorMessage.
+     */
+    virtual void reportTokenMessage(const ErrorLogger::TokenMessage &msg);
+
+    /** @brief Is the message with this id at this location suppressed? */
+    bool isSuppressed(const std::string &id, const std::string &file, unsigned int line);
+
     /**
      * @brief Information about progress is directed here.
      *
@@ -171,6 +226,10 @@ private:
     static void replaceAll(std::string& code, const std::string &from, const std::string &to);
 
     std::list<std::string> _errorList;
+
+    /** @brief The messages in _errorList, for fast duplicate lookups */
+    std::set<std::string> _errorSet;
+
     Settings _settings;
     std::string _fileContent;
     std::set<std::string> _dependencies;
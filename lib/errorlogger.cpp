@@ -25,8 +25,8 @@
 #include <sstream>
 #include <vector>
 
-InternalError::InternalError(const Token *tok, const std::string &errorMsg) :
-    token(tok), errorMessage(errorMsg)
+InternalError::InternalError(const Token *tok, const std::string &errorMsg, Type type_) :
+    token(tok), errorMessage(errorMsg), type(type_)
 {
 }
 
@@ -353,6 +353,54 @@ std::string ErrorLogger::callStackToString(const std::list<ErrorLogger::ErrorMes
 }
 
 
+ErrorLogger::TokenMessage::TokenMessage(const Token *tok, const TokenList *list, Severity::SeverityType severity, const std::string &id, const std::string &msg, bool inconclusive)
+    : _size(0), _list(list), _severity(severity), _id(id), _msg(msg), _inconclusive(inconclusive)
+{
+    addLocation(tok);
+}
+
+ErrorLogger::TokenMessage::TokenMessage(const std::list<const Token *> &callstack, const TokenList *list, Severity::SeverityType severity, const std::string &id, const std::string &msg, bool inconclusive)
+    : _size(0), _list(list), _severity(severity), _id(id), _msg(msg), _inconclusive(inconclusive)
+{
+    for (std::list<const Token *>::const_iterator it = callstack.begin(); it != callstack.end(); ++it)
+        addLocation(*it);
+}
+
+void ErrorLogger::TokenMessage::addLocation(const Token *tok)
+{
+    // --errorlist can provide null values here
+    if (!tok)
+        return;
+
+    Location loc;
+    loc.fileIndex = tok->fileIndex();
+    loc.line = tok->linenr();
+    if (_size < InlineLocations)
+        _inlineLocations[_size] = loc;
+    else
+        _moreLocations.push_back(loc);
+    ++_size;
+}
+
+const std::string &ErrorLogger::TokenMessage::file(const Location &loc) const
+{
+    return _list->getFiles().at(loc.fileIndex);
+}
+
+ErrorLogger::ErrorMessage ErrorLogger::TokenMessage::toErrorMessage() const
+{
+    std::list<ErrorMessage::FileLocation> callStack;
+    for (std::size_t i = 0; i < _size; ++i) {
+        const Location &loc = location(i);
+        callStack.push_back(ErrorMessage::FileLocation(file(loc), loc.line));
+    }
+
+    ErrorMessage errmsg(callStack, _severity, _msg, _id, _inconclusive);
+    if (_list && !_list->getFiles().empty())
+        errmsg.file0 = _list->getFiles()[0];
+    return errmsg;
+}
+
 ErrorLogger::ErrorMessage::FileLocation::FileLocation(const Token* tok, const TokenList* list)
     : line(tok->linenr()), _file(list->file(tok))
 {
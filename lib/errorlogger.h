@@ -22,6 +22,7 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include "config.h"
 #include "suppressions.h"
@@ -34,9 +35,12 @@ class TokenList;
 
 /** @brief Simple container to be thrown when internal error is detected. */
 struct InternalError {
-    InternalError(const Token *tok, const std::string &errorMsg);
+    /** @brief LIMIT and TIMEOUT mean that a configured limit was exceeded */
+    enum Type {INTERNAL, LIMIT, TIMEOUT};
+    InternalError(const Token *tok, const std::string &errorMsg, Type type = INTERNAL);
     const Token *token;
     std::string errorMessage;
+    Type type;
 };
 
 /** @brief enum class for severity. Used when reporting errors. */
@@ -258,6 +262,68 @@ public:
         std::string _verboseMessage;
     };
 
+    /**
+     * An error message as a check reports it. The locations are line
+     * numbers and indexes into TokenList::getFiles(), the first ones are
+     * stored without allocation. The id and message are referenced, not
+     * copied, and the message is only split into the short and verbose
+     * texts by toErrorMessage(). The referenced strings and the token
+     * list must outlive the TokenMessage, so it is only passed down
+     * during a report.
+     */
+    class CPPCHECKLIB TokenMessage {
+    public:
+        /** @brief A line in one of the files of the token list */
+        struct Location {
+            unsigned int fileIndex;
+            unsigned int line;
+        };
+
+        TokenMessage(const Token *tok, const TokenList *list, Severity::SeverityType severity, const std::string &id, const std::string &msg, bool inconclusive);
+        TokenMessage(const std::list<const Token *> &callstack, const TokenList *list, Severity::SeverityType severity, const std::string &id, const std::string &msg, bool inconclusive);
+
+        /** @brief Number of locations in the call stack */
+        std::size_t size() const {
+            return _size;
+        }
+
+        /** @brief Location i of the call stack */
+        const Location &location(std::size_t i) const {
+            return i < InlineLocations ? _inlineLocations[i] : _moreLocations[i - InlineLocations];
+        }
+
+        /** @brief File name of a location */
+        const std::string &file(const Location &loc) const;
+
+        const std::string &id() const {
+            return _id;
+        }
+
+        Severity::SeverityType severity() const {
+            return _severity;
+        }
+
+        /** @brief Create the ErrorMessage that an ErrorLogger receives */
+        ErrorMessage toErrorMessage() const;
+
+    private:
+        void addLocation(const Token *tok);
+
+        enum { InlineLocations = 2 };
+        Location _inlineLocations[InlineLocations];
+        std::vector<Location> _moreLocations;
+        std::size_t _size;
+
+        const TokenList * const _list;
+        const Severity::SeverityType _severity;
+        const std::string &_id;
+        const std::string &_msg;
+        const bool _inconclusive;
+
+        /** disabled assignment operator */
+        void operator=(const TokenMessage &);
+    };
+
     ErrorLogger() { }
     virtual ~ErrorLogger() { }
 
@@ -277,6 +343,17 @@ public:
      */
     virtual void reportErr(const ErrorLogger::ErrorMessage &msg) = 0;
 
+    /**
+     * Errors that the checks find are directed here. By default they
+     * are converted and passed to reportErr(). Override this to drop
+     * messages before they are converted.
+     *
+     * @param msg Location and other information about the found error.
+     */
+    virtual void reportTokenMessage(const ErrorLogger::TokenMessage &msg) {
+        reportErr(msg.toErrorMessage());
+    }
+
     /**
      * Report progress to client
      * @param filename main file that is checked
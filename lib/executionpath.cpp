@@ -18,6 +18,7 @@
 
 
 #include "executionpath.h"
+#include "check.h"
 #include "token.h"
 #include "symboldatabase.h"
 #include <memory>
@@ -137,6 +138,12 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
     const std::auto_ptr<ExecutionPath> check(checks.front()->copy());
 
     for (; tok; tok = tok->next()) {
+        // bail out when checking has run out of time
+        if (check->owner && check->owner->timedOut()) {
+            ExecutionPath::bailOut(checks);
+            return;
+        }
+
         // might be a noreturn function..
         if (Token::simpleMatch(tok->tokAt(-2), ") ; }") &&
             Token::Match(tok->linkAt(-2)->tokAt(-2), "[;{}] %var% (") &&
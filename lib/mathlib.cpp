@@ -27,30 +27,80 @@
 #include <cmath>
 #include <cctype>
 
+/**
+ * Parse an integer in the given base the way std::istringstream would:
+ * leading whitespace and a sign are skipped, hexadecimal numbers may have
+ * a 0x prefix and parsing stops at the first character that is not a
+ * digit. Values that are out of range are clamped.
+ * @param str string to parse
+ * @param base 8, 10 or 16
+ * @param isUnsigned parse as unsigned long long instead of bigint
+ * @return parsed value
+ */
+static MathLib::bigint parseInteger(const std::string &str, unsigned int base, bool isUnsigned)
+{
+    std::string::size_type pos = 0;
+    while (pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos])))
+        ++pos;
+
+    bool negative = false;
+    if (pos < str.size() && (str[pos] == '-' || str[pos] == '+')) {
+        negative = (str[pos] == '-');
+        ++pos;
+    }
+
+    if (base == 16 && (str.compare(pos, 2, "0x") == 0 || str.compare(pos, 2, "0X") == 0))
+        pos += 2;
+
+    const unsigned long long maxValue = ~0ULL;
+    unsigned long long value = 0;
+    bool overflow = false;
+    for (; pos < str.size(); ++pos) {
+        const char c = str[pos];
+        unsigned int digit;
+        if (c >= '0' && c <= '9')
+            digit = static_cast<unsigned int>(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            digit = static_cast<unsigned int>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            digit = static_cast<unsigned int>(c - 'A' + 10);
+        else
+            break;
+        if (digit >= base)
+            break;
+
+        if (value > (maxValue - digit) / base)
+            overflow = true;
+        else
+            value = value * base + digit;
+    }
+
+    if (isUnsigned) {
+        if (overflow)
+            return static_cast<MathLib::bigint>(maxValue);
+        return static_cast<MathLib::bigint>(negative ? (0ULL - value) : value);
+    }
+
+    const unsigned long long maxSigned = maxValue >> 1;
+    if (negative) {
+        if (overflow || value > maxSigned + 1)
+            return -static_cast<MathLib::bigint>(maxSigned) - 1;
+        return static_cast<MathLib::bigint>(0ULL - value);
+    }
+    if (overflow || value > maxSigned)
+        return static_cast<MathLib::bigint>(maxSigned);
+    return static_cast<MathLib::bigint>(value);
+}
+
 MathLib::bigint MathLib::toLongNumber(const std::string &str)
 {
     // hexadecimal numbers:
-    if (isHex(str)) {
-        if (str[0] == '-') {
-            bigint ret = 0;
-            std::istringstream istr(str);
-            istr >> std::hex >> ret;
-            return ret;
-        } else {
-            unsigned long long ret = 0;
-            std::istringstream istr(str);
-            istr >> std::hex >> ret;
-            return (bigint)ret;
-        }
-    }
+    if (isHex(str))
+        return parseInteger(str, 16, str[0] != '-');
 
     // octal numbers:
-    if (isOct(str)) {
-        bigint ret = 0;
-        std::istringstream istr(str);
-        istr >> std::oct >> ret;
-        return ret;
-    }
+    if (isOct(str))
+        return parseInteger(str, 8, false);
 
     // binary numbers:
     if (isBin(str)) {
@@ -68,17 +118,22 @@ MathLib::bigint MathLib::toLongNumber(const std::string &str)
     if (str.find_first_of("eE") != std::string::npos)
         return static_cast<bigint>(std::atof(str.c_str()));
 
-    bigint ret = 0;
-    std::istringstream istr(str);
-    istr >> ret;
-    return ret;
+    return parseInteger(str, 10, false);
 }
 
 std::string MathLib::longToString(const bigint value)
 {
-    std::ostringstream result;
-    result << value;
-    return result.str();
+    // format the digits backwards into a buffer
+    char buf[32];
+    char *p = buf + sizeof(buf);
+    unsigned long long u = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    do {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (value < 0)
+        *--p = '-';
+    return std::string(p, buf + sizeof(buf));
 }
 
 double MathLib::toDoubleNumber(const std::string &str)
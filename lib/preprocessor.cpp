@@ -23,12 +23,14 @@
 #include "path.h"
 #include "errorlogger.h"
 #include "settings.h"
+#include "mathlib.h"
 
 #include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <cstdlib>
 #include <cctype>
+#include <limits>
 #include <vector>
 #include <set>
 #include <stack>
@@ -488,7 +490,7 @@ std::string Preprocessor::removeComments(const std::string &str, const std::stri
 
                 // First check for a "fall through" comment match, but only
                 // add a suppression if the next token is 'case' or 'default'
-                if (_settings && _settings->isEnabled("style") && _settings->experimental && fallThroughComment) {
+                if (_settings && _settings->isEnabled(Settings::Style) && _settings->experimental && fallThroughComment) {
                     std::string::size_type j = str.find_first_not_of("abcdefghijklmnopqrstuvwxyz", i);
                     std::string tok = str.substr(i, j - i);
                     if (tok == "case" || tok == "default")
@@ -1439,7 +1441,426 @@ std::list<std::string> Preprocessor::getcfgs(const std::string &filedata, const
 }
 
 
+/** split a #if condition into names, numbers and operators */
+static void lexCondition(const std::string &condition, std::vector<std::string> &tokens)
+{
+    static const char * const operators[] = { "&&", "||", "==", "!=", "<=", ">=", "<<", ">>" };
+
+    for (std::string::size_type pos = 0; pos < condition.size();) {
+        const unsigned char c = static_cast<unsigned char>(condition[pos]);
+        if (std::isspace(c)) {
+            ++pos;
+            continue;
+        }
+
+        std::string::size_type end = pos + 1;
+        if (std::isalnum(c) || c == '_') {
+            while (end < condition.size() && (std::isalnum(static_cast<unsigned char>(condition[end])) || condition[end] == '_' || (std::isdigit(c) && condition[end] == '.')))
+                ++end;
+        } else {
+            for (std::size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); ++i) {
+                if (condition.compare(pos, 2, operators[i]) == 0) {
+                    end = pos + 2;
+                    break;
+                }
+            }
+        }
+        tokens.push_back(condition.substr(pos, end - pos));
+        pos = end;
+    }
+}
+
+static bool isConditionName(const std::string &tok)
+{
+    return std::isalpha(static_cast<unsigned char>(tok[0])) || tok[0] == '_';
+}
+
+/**
+ * Replace defined() and the macros in a lexed condition with their values
+ * @return false if there are macros or defined() that have no known value
+ */
+static bool substituteCondition(const std::map<std::string, std::string> &cfg, const std::vector<std::string> &tokens, bool match, std::vector<std::string> &result)
+{
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        const std::string &tok = tokens[i];
+        if (!isConditionName(tok)) {
+            result.push_back(tok);
+            continue;
+        }
+
+        if (tok == "defined") {
+            std::string name;
+            if (i + 3 < tokens.size() && tokens[i+1] == "(" && isConditionName(tokens[i+2]) && tokens[i+3] == ")") {
+                name = tokens[i+2];
+                i += 3;
+            } else if (i + 1 < tokens.size() && isConditionName(tokens[i+1])) {
+                name = tokens[i+1];
+                ++i;
+            } else
+                return false;
+
+            if (cfg.find(name) != cfg.end())
+                result.push_back("1");
+            else if (match)
+                result.push_back("0");
+            else
+                return false;
+            continue;
+        }
+
+        const std::map<std::string, std::string>::const_iterator it = cfg.find(tok);
+        if (it == cfg.end())
+            return false;
+
+        if (it->second.empty()) {
+            // a macro without value is true when it is a complete operand of && or ||
+            const bool before = (i == 0 || tokens[i-1] == "&&" || tokens[i-1] == "||" || tokens[i-1] == "(");
+            const bool after = (i + 1 == tokens.size() || tokens[i+1] == "&&" || tokens[i+1] == "||" || tokens[i+1] == ")");
+            if (!before || !after)
+                return false;
+            result.push_back("1");
+        } else {
+            std::vector<std::string> value;
+            lexCondition(it->second, value);
+            for (std::size_t j = 0; j < value.size(); ++j) {
+                if (isConditionName(value[j]))
+                    return false;
+                result.push_back(value[j]);
+            }
+        }
+    }
+    return true;
+}
+
+namespace {
+    /** @brief Evaluates an integer constant expression in a #if condition */
+    class ConditionEvaluator {
+    public:
+        explicit ConditionEvaluator(const std::vector<std::string> &tokens) : _tokens(tokens), _pos(0) {
+        }
+
+        /** @return false if the expression is invalid or can't be evaluated */
+        bool evaluate(MathLib::bigint &value) {
+            return conditional(value) && _pos == _tokens.size();
+        }
+
+    private:
+        const std::vector<std::string> &_tokens;
+        std::size_t _pos;
+
+        /** @brief is "a + b" outside the range of bigint? */
+        static bool additionOverflows(MathLib::bigint a, MathLib::bigint b) {
+            if (b > 0)
+                return a > std::numeric_limits<MathLib::bigint>::max() - b;
+            return a < std::numeric_limits<MathLib::bigint>::min() - b;
+        }
+
+        /** @brief is "a * b" outside the range of bigint? */
+        static bool multiplicationOverflows(MathLib::bigint a, MathLib::bigint b) {
+            if (a == 0 || b == 0)
+                return false;
+            if (a == -1)
+                return b == std::numeric_limits<MathLib::bigint>::min();
+            if (b == -1)
+                return a == std::numeric_limits<MathLib::bigint>::min();
+            if ((a > 0) == (b > 0))
+                return (a > 0) ? (a > std::numeric_limits<MathLib::bigint>::max() / b)
+                       : (a < std::numeric_limits<MathLib::bigint>::max() / b);
+            return (a > 0) ? (b < std::numeric_limits<MathLib::bigint>::min() / a)
+                   : (a < std::numeric_limits<MathLib::bigint>::min() / b);
+        }
+
+        bool accept(const char op[]) {
+            if (_pos < _tokens.size() && _tokens[_pos] == op) {
+                ++_pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool conditional(MathLib::bigint &value) {
+            if (!logicalOr(value))
+                return false;
+            if (accept("?")) {
+                MathLib::bigint value1, value2;
+                if (!conditional(value1) || !accept(":") || !conditional(value2))
+                    return false;
+                value = value ? value1 : value2;
+            }
+            return true;
+        }
+
+        bool logicalOr(MathLib::bigint &value) {
+            if (!logicalAnd(value))
+                return false;
+            MathLib::bigint rhs;
+            while (accept("||")) {
+                if (!logicalAnd(rhs))
+                    return false;
+                value = (value || rhs) ? 1 : 0;
+            }
+            return true;
+        }
+
+        bool logicalAnd(MathLib::bigint &value) {
+            if (!bitOr(value))
+                return false;
+            MathLib::bigint rhs;
+            while (accept("&&")) {
+                if (!bitOr(rhs))
+                    return false;
+                value = (value && rhs) ? 1 : 0;
+            }
+            return true;
+        }
+
+        bool bitOr(MathLib::bigint &value) {
+            if (!bitXor(value))
+                return false;
+            MathLib::bigint rhs;
+            while (accept("|")) {
+                if (!bitXor(rhs))
+                    return false;
+                value |= rhs;
+            }
+            return true;
+        }
+
+        bool bitXor(MathLib::bigint &value) {
+            if (!bitAnd(value))
+                return false;
+            MathLib::bigint rhs;
+            while (accept("^")) {
+                if (!bitAnd(rhs))
+                    return false;
+                value ^= rhs;
+            }
+            return true;
+        }
+
+        bool bitAnd(MathLib::bigint &value) {
+            if (!equality(value))
+                return false;
+            MathLib::bigint rhs;
+            while (accept("&")) {
+                if (!equality(rhs))
+                    return false;
+                value &= rhs;
+            }
+            return true;
+        }
+
+        bool equality(MathLib::bigint &value) {
+            if (!relational(value))
+                return false;
+            MathLib::bigint rhs;
+            for (;;) {
+                if (accept("==")) {
+                    if (!relational(rhs))
+                        return false;
+                    value = (value == rhs) ? 1 : 0;
+                } else if (accept("!=")) {
+                    if (!relational(rhs))
+                        return false;
+                    value = (value != rhs) ? 1 : 0;
+                } else
+                    return true;
+            }
+        }
+
+        bool relational(MathLib::bigint &value) {
+            if (!shift(value))
+                return false;
+            MathLib::bigint rhs;
+            for (;;) {
+                if (accept("<")) {
+                    if (!shift(rhs))
+                        return false;
+                    value = (value < rhs) ? 1 : 0;
+                } else if (accept("<=")) {
+                    if (!shift(rhs))
+                        return false;
+                    value = (value <= rhs) ? 1 : 0;
+                } else if (accept(">")) {
+                    if (!shift(rhs))
+                        return false;
+                    value = (value > rhs) ? 1 : 0;
+                } else if (accept(">=")) {
+                    if (!shift(rhs))
+                        return false;
+                    value = (value >= rhs) ? 1 : 0;
+                } else
+                    return true;
+            }
+        }
+
+        bool shift(MathLib::bigint &value) {
+            if (!additive(value))
+                return false;
+            MathLib::bigint rhs;
+            for (;;) {
+                const bool left = accept("<<");
+                if (!left && !accept(">>"))
+                    return true;
+                if (!additive(rhs) || rhs < 0 || rhs >= 63)
+                    return false;
+                // shifting a negative value or shifting bits out is not evaluated here
+                if (left && (value < 0 || value > (std::numeric_limits<MathLib::bigint>::max() >> rhs)))
+                    return false;
+                value = left ? (value << rhs) : (value >> rhs);
+            }
+        }
+
+        bool additive(MathLib::bigint &value) {
+            if (!multiplicative(value))
+                return false;
+            MathLib::bigint rhs;
+            for (;;) {
+                const bool plus = accept("+");
+                if (!plus && !accept("-"))
+                    return true;
+                if (!multiplicative(rhs))
+                    return false;
+                if (!plus) {
+                    if (rhs == std::numeric_limits<MathLib::bigint>::min())
+                        return false;
+                    rhs = -rhs;
+                }
+                if (additionOverflows(value, rhs))
+                    return false;
+                value += rhs;
+            }
+        }
+
+        bool multiplicative(MathLib::bigint &value) {
+            if (!unary(value))
+                return false;
+            MathLib::bigint rhs;
+            for (;;) {
+                if (accept("*")) {
+                    if (!unary(rhs) || multiplicationOverflows(value, rhs))
+                        return false;
+                    value *= rhs;
+                } else if (accept("/") || accept("%")) {
+                    const bool div = (_tokens[_pos-1] == "/");
+                    if (!unary(rhs) || rhs == 0 || rhs == -1)
+                        return false;
+                    value = div ? (value / rhs) : (value % rhs);
+                } else
+                    return true;
+            }
+        }
+
+        bool unary(MathLib::bigint &value) {
+            if (accept("!")) {
+                if (!unary(value))
+                    return false;
+                value = value ? 0 : 1;
+                return true;
+            }
+            if (accept("~")) {
+                if (!unary(value))
+                    return false;
+                value = ~value;
+                return true;
+            }
+            if (accept("-")) {
+                if (!unary(value) || value == std::numeric_limits<MathLib::bigint>::min())
+                    return false;
+                value = -value;
+                return true;
+            }
+            if (accept("+"))
+                return unary(value);
+            return primary(value);
+        }
+
+        bool primary(MathLib::bigint &value) {
+            if (accept("(")) {
+                return conditional(value) && accept(")");
+            }
+            if (_pos < _tokens.size() && std::isdigit(static_cast<unsigned char>(_tokens[_pos][0])) && MathLib::isInt(_tokens[_pos])) {
+                // unsigned operands change the arithmetic, leave them to the tokenizer
+                if (_tokens[_pos].find_first_of("uU") != std::string::npos)
+                    return false;
+                value = MathLib::toLongNumber(_tokens[_pos]);
+                ++_pos;
+                return true;
+            }
+            return false;
+        }
+    };
+}
+
+/**
+ * Evaluate a #if condition without the tokenizer
+ * @return false if the condition can't be evaluated, then the tokenizer
+ * must be used to simplify it
+ */
+static bool evaluateCondition(const std::map<std::string, std::string> &cfg, const std::vector<std::string> &tokens, bool match, std::string &condition)
+{
+    // "A" and "!A" are only checked against the cfg
+    if (tokens.size() == 1U && isConditionName(tokens[0])) {
+        const std::map<std::string, std::string>::const_iterator var = cfg.find(tokens[0]);
+        if (var != cfg.end())
+            condition = (var->second == "0") ? "0" : "1";
+        else if (match)
+            condition = "0";
+        return true;
+    }
+    if (tokens.size() == 2U && tokens[0] == "!" && isConditionName(tokens[1])) {
+        const std::map<std::string, std::string>::const_iterator var = cfg.find(tokens[1]);
+        if (var == cfg.end() || var->second == "0")
+            condition = "1";
+        else if (match)
+            condition = "0";
+        return true;
+    }
+
+    std::vector<std::string> expr;
+    if (!substituteCondition(cfg, tokens, match, expr))
+        return false;
+
+    MathLib::bigint value = 0;
+    ConditionEvaluator evaluator(expr);
+    if (!evaluator.evaluate(value))
+        return false;
+    condition = value ? "1" : "0";
+    return true;
+}
+
 void Preprocessor::simplifyCondition(const std::map<std::string, std::string> &cfg, std::string &condition, bool match)
+{
+    std::vector<std::string> tokens;
+    lexCondition(condition, tokens);
+
+    // The result only depends on the condition and the values of the
+    // macros that are used in it
+    std::string key(condition);
+    key += match ? "\n1" : "\n0";
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        if (!isConditionName(tokens[i]) || tokens[i] == "defined")
+            continue;
+        const std::map<std::string, std::string>::const_iterator var = cfg.find(tokens[i]);
+        key += ";" + tokens[i];
+        if (var == cfg.end())
+            key += "!";
+        else
+            key += "=" + var->second;
+    }
+
+    const std::map<std::string, std::string>::const_iterator cached = _conditionCache.find(key);
+    if (cached != _conditionCache.end()) {
+        condition = cached->second;
+        return;
+    }
+
+    if (!evaluateCondition(cfg, tokens, match, condition))
+        simplifyConditionWithTokenizer(cfg, condition, match);
+    _conditionCache[key] = condition;
+}
+
+void Preprocessor::simplifyConditionWithTokenizer(const std::map<std::string, std::string> &cfg, std::string &condition, bool match)
 {
     const Settings settings;
     Tokenizer tokenizer(&settings, _errorLogger);
@@ -1509,6 +1930,7 @@ void Preprocessor::simplifyCondition(const std::map<std::string, std::string> &c
                 std::stack<Token *> link;
                 for (const Token *tok2 = tokenizer2.tokens(); tok2; tok2 = tok2->next()) {
                     tok->str(tok2->str());
+                    tok->isUnsigned(tok2->isUnsigned());
 
                     if (Token::Match(tok2,"[{([]"))
                         link.push(tok);
@@ -1655,42 +2077,38 @@ std::string Preprocessor::getcode(const std::string &filedata, const std::string
     std::stack<std::string> filenames;
     filenames.push(filename);
     std::stack<unsigned int> lineNumbers;
-    std::istringstream istr(filedata);
-    std::string line;
-    while (std::getline(istr, line)) {
-        ++lineno;
 
-        if (line.compare(0, 11, "#pragma asm") == 0) {
-            ret << "\n";
-            bool found_end = false;
-            while (getline(istr, line)) {
-                if (line.compare(0, 14, "#pragma endasm") == 0) {
-                    found_end = true;
-                    break;
-                }
+    // The lines are only split and classified once for all configurations
+    if (_linesData != filedata)
+        parseLines(filedata);
 
+    for (std::vector<Line>::const_iterator iter = _lines.begin(); iter != _lines.end(); ++iter) {
+        if (iter->type == Line::Code) {
+            // code lines are kept if they belong to this configuration
+            lineno += iter->count;
+            if (match) {
+                ret.write(filedata.data() + iter->start, (std::streamsize)(iter->end - iter->start));
                 ret << "\n";
-            }
-            if (!found_end)
-                break;
+            } else
+                ret << std::string(iter->count, '\n');
+            continue;
+        }
 
-            if (line.find("=") != std::string::npos) {
-                Tokenizer tokenizer(_settings, NULL);
-                line.erase(0, sizeof("#pragma endasm"));
-                std::istringstream tempIstr(line);
-                tokenizer.tokenize(tempIstr, "");
-                if (Token::Match(tokenizer.tokens(), "( %var% = %any% )")) {
-                    ret << "asm(" << tokenizer.tokens()->strAt(1) << ");";
-                }
-            }
+        ++lineno;
 
-            ret << "\n";
+        if (iter->type == Line::UnterminatedAsm) {
+            ret << std::string(iter->count, '\n');
+            break;
+        }
 
+        if (iter->type == Line::Asm) {
+            ret << std::string(iter->count - 1U, '\n') << iter->text << "\n";
             continue;
         }
 
-        const std::string def = getdef(line, true);
-        const std::string ndef = getdef(line, false);
+        std::string line(iter->text);
+        const std::string &def = iter->def;
+        const std::string &ndef = iter->ndef;
 
         const bool emptymatch = matching_ifdef.empty() | matched_ifdef.empty();
 
@@ -1836,7 +2254,73 @@ std::string Preprocessor::getcode(const std::string &filedata, const std::string
         return "";
     }
 
-    return expandMacros(ret.str(), filename, cfg, _errorLogger);
+    return expandMacros(ret.str(), filename, cfg, _errorLogger, _macroDefinitions);
+}
+
+void Preprocessor::parseLines(const std::string &filedata)
+{
+    _linesData = filedata;
+    _lines.clear();
+
+    std::string::size_type pos = 0;
+    while (pos < filedata.size()) {
+        std::string::size_type end = filedata.find('\n', pos);
+        if (end == std::string::npos)
+            end = filedata.size();
+        const std::string::size_type next = (end < filedata.size()) ? end + 1 : end;
+
+        Line line;
+        line.start = pos;
+        line.end = end;
+        line.count = 1;
+
+        if (filedata.compare(pos, 11, "#pragma asm") == 0) {
+            // the asm block is replaced with empty lines. If it ends with
+            // "#pragma endasm ( x = y )" then "asm(x);" is written.
+            line.type = Line::UnterminatedAsm;
+            pos = next;
+            while (pos < filedata.size()) {
+                end = filedata.find('\n', pos);
+                if (end == std::string::npos)
+                    end = filedata.size();
+                ++line.count;
+                const std::string::size_type asmEnd = pos;
+                pos = (end < filedata.size()) ? end + 1 : end;
+                if (filedata.compare(asmEnd, 14, "#pragma endasm") == 0) {
+                    line.type = Line::Asm;
+                    std::string endasm(filedata.substr(asmEnd, end - asmEnd));
+                    if (endasm.find("=") != std::string::npos) {
+                        Tokenizer tokenizer(_settings, NULL);
+                        endasm.erase(0, sizeof("#pragma endasm"));
+                        std::istringstream tempIstr(endasm);
+                        tokenizer.tokenize(tempIstr, "");
+                        if (Token::Match(tokenizer.tokens(), "( %var% = %any% )"))
+                            line.text = "asm(" + tokenizer.tokens()->strAt(1) + ");";
+                    }
+                    break;
+                }
+            }
+            _lines.push_back(line);
+            continue;
+        }
+
+        if (filedata[pos] == '#') {
+            line.type = Line::Directive;
+            line.text = filedata.substr(pos, end - pos);
+            line.def = getdef(line.text, true);
+            line.ndef = getdef(line.text, false);
+            _lines.push_back(line);
+        } else if (!_lines.empty() && _lines.back().type == Line::Code) {
+            // append the line to the previous block of code
+            _lines.back().end = end;
+            ++_lines.back().count;
+        } else {
+            line.type = Line::Code;
+            _lines.push_back(line);
+        }
+
+        pos = next;
+    }
 }
 
 void Preprocessor::error(const std::string &filename, unsigned int linenr, const std::string &msg)
@@ -2349,10 +2833,11 @@ static void getparams(const std::string &line,
 /** @brief Class that the preprocessor uses when it expands macros. This class represents a preprocessor macro */
 class PreprocessorMacro {
 private:
-    Settings settings;
-
     /** tokens of this macro */
-    Tokenizer tokenizer;
+    std::vector<std::string> _tokens;
+
+    /** for each token in _tokens: index in _params of the parameter that the token (or "#parameter") uses, -1 if it is not a parameter */
+    std::vector<int> _paramIndex;
 
     /** macro parameters */
     std::vector<std::string> _params;
@@ -2375,24 +2860,42 @@ private:
     /** disabled assignment operator */
     void operator=(const PreprocessorMacro &);
 
+    static bool isName(const std::string &str) {
+        return str[0] == '_' || std::isalpha(str[0]);
+    }
+
+    static bool isNumber(const std::string &str) {
+        return std::isdigit(str[0]) || (str.length() > 1 && str[0] == '-' && std::isdigit(str[1]));
+    }
+
+    /** is token i equal to str? */
+    bool tokenIs(std::size_t i, const char str[]) const {
+        return i < _tokens.size() && _tokens[i] == str;
+    }
+
+    /** index of the first ")" in the macro, _tokens.size() if there is none */
+    std::size_t endOfParameters() const {
+        return std::find(_tokens.begin(), _tokens.end(), ")") - _tokens.begin();
+    }
+
     /** @brief expand inner macro */
     std::vector<std::string> expandInnerMacros(const std::vector<std::string> &params1,
-            const std::map<std::string, PreprocessorMacro *> &macros) const {
+            const std::map<std::string, const PreprocessorMacro *> &macros) const {
         std::string innerMacroName;
 
         // Is there an inner macro..
         {
-            const Token *tok = Token::findsimplematch(tokens(), ")");
-            if (!Token::Match(tok, ") %var% ("))
+            std::size_t i = endOfParameters();
+            if (!(i + 2 < _tokens.size() && isName(_tokens[i+1]) && _tokens[i+2] == "("))
                 return params1;
-            innerMacroName = tok->strAt(1);
-            tok = tok->tokAt(3);
+            innerMacroName = _tokens[i+1];
+            i += 3;
             unsigned int par = 0;
-            while (Token::Match(tok, "%var% ,|)")) {
-                tok = tok->tokAt(2);
+            while (i + 1 < _tokens.size() && isName(_tokens[i]) && (_tokens[i+1] == "," || _tokens[i+1] == ")")) {
+                i += 2;
                 par++;
             }
-            if (tok || par != params1.size())
+            if (i < _tokens.size() || par != params1.size())
                 return params1;
         }
 
@@ -2409,13 +2912,13 @@ private:
                 getparams(param, pos, innerparams, num, endFound);
                 if (pos == param.length()-1 && num==0 && endFound && innerparams.size() == params1.size()) {
                     // Is inner macro defined?
-                    std::map<std::string, PreprocessorMacro *>::const_iterator it = macros.find(innerMacroName);
+                    std::map<std::string, const PreprocessorMacro *>::const_iterator it = macros.find(innerMacroName);
                     if (it != macros.end()) {
                         // expand the inner macro
                         const PreprocessorMacro *innerMacro = it->second;
 
                         std::string innercode;
-                        std::map<std::string,PreprocessorMacro *> innermacros = macros;
+                        std::map<std::string, const PreprocessorMacro *> innermacros = macros;
                         innermacros.erase(innerMacroName);
                         innerMacro->code(innerparams, innermacros, innercode);
                         params2[ipar] = innercode;
@@ -2436,15 +2939,18 @@ public:
      */
     explicit PreprocessorMacro(const std::string &macro)
         : _macro(macro), _prefix("__cppcheck__") {
-        tokenizer.setSettings(&settings);
-
-        // Tokenize the macro to make it easier to handle
-        std::istringstream istr(macro);
-        tokenizer.list.createTokens(istr);
+        // Tokenize the macro to make it easier to handle. Only the token
+        // strings are kept.
+        {
+            TokenList tokenlist(NULL);
+            tokenlist.createTokens(macro);
+            for (const Token *tok = tokenlist.front(); tok; tok = tok->next())
+                _tokens.push_back(tok->str());
+        }
 
         // macro name..
-        if (tokens() && tokens()->isName())
-            _name = tokens()->str();
+        if (!_tokens.empty() && isName(_tokens[0]))
+            _name = _tokens[0];
 
         // initialize parameters to default values
         _variadic = _nopar = false;
@@ -2452,32 +2958,40 @@ public:
         std::string::size_type pos = macro.find_first_of(" (");
         if (pos != std::string::npos && macro[pos] == '(') {
             // Extract macro parameters
-            if (Token::Match(tokens(), "%var% ( %var%")) {
-                for (const Token *tok = tokens()->tokAt(2); tok; tok = tok->next()) {
-                    if (tok->str() == ")")
+            if (!_name.empty() && tokenIs(1, "(") && _tokens.size() > 2 && isName(_tokens[2])) {
+                for (std::size_t i = 2; i < _tokens.size(); ++i) {
+                    if (_tokens[i] == ")")
                         break;
-                    if (Token::simpleMatch(tok, ". . . )")) {
-                        if (tok->previous()->str() == ",")
+                    if (_tokens[i] == "." && tokenIs(i+1, ".") && tokenIs(i+2, ".") && tokenIs(i+3, ")")) {
+                        if (_tokens[i-1] == ",")
                             _params.push_back("__VA_ARGS__");
                         _variadic = true;
                         break;
                     }
-                    if (tok->isName())
-                        _params.push_back(tok->str());
+                    if (isName(_tokens[i]))
+                        _params.push_back(_tokens[i]);
                 }
             }
 
-            else if (Token::Match(tokens(), "%var% ( . . . )"))
+            else if (!_name.empty() && tokenIs(1, "(") && tokenIs(2, ".") && tokenIs(3, ".") && tokenIs(4, ".") && tokenIs(5, ")"))
                 _variadic = true;
 
-            else if (Token::Match(tokens(), "%var% ( )"))
+            else if (!_name.empty() && tokenIs(1, "(") && tokenIs(2, ")"))
                 _nopar = true;
         }
-    }
 
-    /** return tokens of this macro */
-    const Token *tokens() const {
-        return tokenizer.tokens();
+        // Which parameter does each token use?
+        _paramIndex.resize(_tokens.size(), -1);
+        for (std::size_t i = 0; i < _tokens.size(); ++i) {
+            std::string str = _tokens[i];
+            if (str[0] == '#')
+                str.erase(0, 1);
+            else if (!isName(str))
+                continue;
+            const std::vector<std::string>::const_iterator param = std::find(_params.begin(), _params.end(), str);
+            if (param != _params.end())
+                _paramIndex[i] = (int)(param - _params.begin());
+        }
     }
 
     /** read parameters of this macro */
@@ -2507,7 +3021,7 @@ public:
      * @param macrocode output string
      * @return true if the expanding was successful
      */
-    bool code(const std::vector<std::string> &params2, const std::map<std::string, PreprocessorMacro *> &macros, std::string &macrocode) const {
+    bool code(const std::vector<std::string> &params2, const std::map<std::string, const PreprocessorMacro *> &macros, std::string &macrocode) const {
         if (_nopar || (_params.empty() && _variadic)) {
             macrocode = _macro.substr(1 + _macro.find(")"));
             if (macrocode.empty())
@@ -2555,56 +3069,51 @@ public:
         else {
             const std::vector<std::string> givenparams = expandInnerMacros(params2, macros);
 
-            const Token *tok = tokens();
-            while (tok && tok->str() != ")")
-                tok = tok->next();
-            if (tok) {
+            const std::size_t end = endOfParameters();
+            if (end < _tokens.size()) {
                 bool optcomma = false;
-                while (NULL != (tok = tok->next())) {
-                    std::string str = tok->str();
+                for (std::size_t tok = end + 1; tok < _tokens.size(); ++tok) {
+                    std::string str = _tokens[tok];
                     if (str == "##")
                         continue;
-                    if (str[0] == '#' || tok->isName()) {
+                    if (str[0] == '#' || isName(str)) {
                         const bool stringify(str[0] == '#');
                         if (stringify) {
                             str = str.erase(0, 1);
                         }
-                        for (unsigned int i = 0; i < _params.size(); ++i) {
-                            if (str == _params[i]) {
-                                if (_variadic &&
-                                    (i == _params.size() - 1 ||
-                                     (givenparams.size() + 2 == _params.size() && i + 1 == _params.size() - 1))) {
-                                    str = "";
-                                    for (unsigned int j = (unsigned int)_params.size() - 1; j < givenparams.size(); ++j) {
-                                        if (optcomma || j > _params.size() - 1)
-                                            str += ",";
-                                        optcomma = false;
-                                        str += givenparams[j];
-                                    }
-                                } else if (i >= givenparams.size()) {
-                                    // Macro had more parameters than caller used.
-                                    macrocode = "";
-                                    return false;
-                                } else if (stringify) {
-                                    const std::string &s(givenparams[i]);
-                                    std::ostringstream ostr;
-                                    ostr << "\"";
-                                    for (std::string::size_type j = 0; j < s.size(); ++j) {
-                                        if (s[j] == '\\' || s[j] == '\"')
-                                            ostr << '\\';
-                                        ostr << s[j];
-                                    }
-                                    str = ostr.str() + "\"";
-                                } else
-                                    str = givenparams[i];
-
-                                break;
-                            }
+                        if (_paramIndex[tok] >= 0) {
+                            const unsigned int i = (unsigned int)_paramIndex[tok];
+                            if (_variadic &&
+                                (i == _params.size() - 1 ||
+                                 (givenparams.size() + 2 == _params.size() && i + 1 == _params.size() - 1))) {
+                                str = "";
+                                for (unsigned int j = (unsigned int)_params.size() - 1; j < givenparams.size(); ++j) {
+                                    if (optcomma || j > _params.size() - 1)
+                                        str += ",";
+                                    optcomma = false;
+                                    str += givenparams[j];
+                                }
+                            } else if (i >= givenparams.size()) {
+                                // Macro had more parameters than caller used.
+                                macrocode = "";
+                                return false;
+                            } else if (stringify) {
+                                const std::string &s(givenparams[i]);
+                                std::ostringstream ostr;
+                                ostr << "\"";
+                                for (std::string::size_type j = 0; j < s.size(); ++j) {
+                                    if (s[j] == '\\' || s[j] == '\"')
+                                        ostr << '\\';
+                                    ostr << s[j];
+                                }
+                                str = ostr.str() + "\"";
+                            } else
+                                str = givenparams[i];
                         }
 
                         // expand nopar macro
-                        if (tok->strAt(-1) != "##") {
-                            const std::map<std::string, PreprocessorMacro *>::const_iterator it = macros.find(str);
+                        if (_tokens[tok-1] != "##") {
+                            const std::map<std::string, const PreprocessorMacro *>::const_iterator it = macros.find(str);
                             if (it != macros.end() && it->second->_macro.find("(") == std::string::npos) {
                                 str = it->second->_macro;
                                 if (str.find(" ") != std::string::npos)
@@ -2614,17 +3123,19 @@ public:
                             }
                         }
                     }
-                    if (_variadic && tok->str() == "," && tok->next() && tok->next()->str() == "##") {
+                    if (_variadic && _tokens[tok] == "," && tokenIs(tok + 1, "##")) {
                         optcomma = true;
                         continue;
                     }
                     optcomma = false;
                     macrocode += str;
-                    if (Token::Match(tok, "%var% %var%") ||
-                        Token::Match(tok, "%var% %num%") ||
-                        Token::Match(tok, "%num% %var%") ||
-                        Token::simpleMatch(tok, "> >"))
-                        macrocode += " ";
+                    if (tok + 1 < _tokens.size()) {
+                        const std::string &next = _tokens[tok+1];
+                        if ((isName(_tokens[tok]) && (isName(next) || isNumber(next))) ||
+                            (isNumber(_tokens[tok]) && isName(next)) ||
+                            (_tokens[tok] == ">" && next == ">"))
+                            macrocode += " ";
+                    }
                 }
             }
         }
@@ -2741,7 +3252,7 @@ bool Preprocessor::validateCfg(const std::string &code, const std::string &cfg)
                 if (pos2 < code.size() && (std::isalnum(code[pos2]) || code[pos2] == '_'))
                     continue;
                 // macro is used in code, return false
-                if (_settings->isEnabled("information"))
+                if (_settings->isEnabled(Settings::Information))
                     validateCfgError(cfg);
                 return false;
             }
@@ -2763,13 +3274,38 @@ void Preprocessor::validateCfgError(const std::string &cfg)
     _errorLogger->reportInfo(errmsg);
 }
 
+Preprocessor::~Preprocessor()
+{
+    for (std::map<std::string, PreprocessorMacro *>::iterator it = _macroDefinitions.begin(); it != _macroDefinitions.end(); ++it)
+        delete it->second;
+}
+
+/** get the macro for a definition, it is created when it is not in "definitions" yet */
+static const PreprocessorMacro *getMacro(std::map<std::string, PreprocessorMacro *> &definitions, const std::string &definition)
+{
+    std::map<std::string, PreprocessorMacro *>::iterator it = definitions.find(definition);
+    if (it == definitions.end())
+        it = definitions.insert(std::make_pair(definition, new PreprocessorMacro(definition))).first;
+    return it->second;
+}
+
 std::string Preprocessor::expandMacros(const std::string &code, std::string filename, const std::string &cfg, ErrorLogger *errorLogger)
+{
+    std::map<std::string, PreprocessorMacro *> definitions;
+    const std::string ret(expandMacros(code, filename, cfg, errorLogger, definitions));
+    for (std::map<std::string, PreprocessorMacro *>::iterator it = definitions.begin(); it != definitions.end(); ++it)
+        delete it->second;
+    return ret;
+}
+
+std::string Preprocessor::expandMacros(const std::string &code, std::string filename, const std::string &cfg, ErrorLogger *errorLogger, std::map<std::string, PreprocessorMacro *> &definitions)
 {
     // Search for macros and expand them..
     // --------------------------------------------
 
-    // Available macros (key=macroname, value=macro).
-    std::map<std::string, PreprocessorMacro *> macros;
+    // Available macros (key=macroname, value=macro). The macros are
+    // owned by "definitions".
+    std::map<std::string, const PreprocessorMacro *> macros;
 
     {
         // fill up "macros" with user defined macros
@@ -2779,8 +3315,7 @@ std::string Preprocessor::expandMacros(const std::string &code, std::string file
             std::string s = it->first;
             if (!it->second.empty())
                 s += " " + it->second;
-            PreprocessorMacro *macro = new PreprocessorMacro(s);
-            macros[it->first] = macro;
+            macros[it->first] = getMacro(definitions, s);
         }
     }
 
@@ -2799,30 +3334,16 @@ std::string Preprocessor::expandMacros(const std::string &code, std::string file
     while (getlines(istr, line)) {
         // defining a macro..
         if (line.compare(0, 8, "#define ") == 0) {
-            PreprocessorMacro *macro = new PreprocessorMacro(line.substr(8));
-            if (macro->name().empty() || macro->name() == "NULL") {
-                delete macro;
-            } else if (macro->name() == "BOOST_FOREACH") {
-                // BOOST_FOREACH is currently too complex to parse, so skip it.
-                delete macro;
-            } else {
-                std::map<std::string, PreprocessorMacro *>::iterator it;
-                it = macros.find(macro->name());
-                if (it != macros.end())
-                    delete it->second;
+            const PreprocessorMacro *macro = getMacro(definitions, line.substr(8));
+            // BOOST_FOREACH is currently too complex to parse, so skip it.
+            if (!macro->name().empty() && macro->name() != "NULL" && macro->name() != "BOOST_FOREACH")
                 macros[macro->name()] = macro;
-            }
             line = "\n";
         }
 
         // undefining a macro..
         else if (line.compare(0, 7, "#undef ") == 0) {
-            std::map<std::string, PreprocessorMacro *>::iterator it;
-            it = macros.find(line.substr(7));
-            if (it != macros.end()) {
-                delete it->second;
-                macros.erase(it);
-            }
+            macros.erase(line.substr(7));
             line = "\n";
         }
 
@@ -2891,10 +3412,6 @@ std::string Preprocessor::expandMacros(const std::string &code, std::string file
                                    "noQuoteCharPair",
                                    std::string("No pair for character (") + ch + "). Can't process file. File is either invalid or unicode, which is currently not supported.");
 
-                        std::map<std::string, PreprocessorMacro *>::iterator it;
-                        for (it = macros.begin(); it != macros.end(); ++it)
-                            delete it->second;
-                        macros.clear();
                         return "";
                     }
 
@@ -2918,7 +3435,7 @@ std::string Preprocessor::expandMacros(const std::string &code, std::string file
                     const std::string id = line.substr(pos1, pos - pos1);
 
                     // is there a macro with this name?
-                    std::map<std::string, PreprocessorMacro *>::const_iterator it;
+                    std::map<std::string, const PreprocessorMacro *>::const_iterator it;
                     it = macros.find(id);
                     if (it == macros.end())
                         break;  // no macro with this name exist
@@ -2973,10 +3490,6 @@ std::string Preprocessor::expandMacros(const std::string &code, std::string file
                                    "syntaxError",
                                    std::string("Syntax error. Not enough parameters for macro '") + macro->name() + "'.");
 
-                        std::map<std::string, PreprocessorMacro *>::iterator iter;
-                        for (iter = macros.begin(); iter != macros.end(); ++iter)
-                            delete iter->second;
-                        macros.clear();
                         return "";
                     }
 
@@ -3027,10 +3540,6 @@ std::string Preprocessor::expandMacros(const std::string &code, std::string file
         }
     }
 
-    for (std::map<std::string, PreprocessorMacro *>::iterator it = macros.begin(); it != macros.end(); ++it)
-        delete it->second;
-    macros.clear();
-
     return ostr.str();
 }
 
@@ -25,10 +25,12 @@
 #include <istream>
 #include <string>
 #include <list>
+#include <vector>
 #include "config.h"
 
 class ErrorLogger;
 class Settings;
+class PreprocessorMacro;
 
 /// @addtogroup Core
 /// @{
@@ -54,6 +56,7 @@ public:
     static char macroChar;
 
     Preprocessor(Settings *settings = 0, ErrorLogger *errorLogger = 0);
+    ~Preprocessor();
 
     static bool missingIncludeFlag;
 
@@ -262,6 +265,53 @@ private:
      */
     void handleIncludes(std::string &code, const std::string &filePath, const std::list<std::string> &includePaths);
 
+    /**
+     * expand macros in code
+     * @param definitions macros that are already created, key is the
+     * definition. New macros are added and must be deleted by the caller.
+     * The definitions can be shared by all configurations of a file.
+     */
+    static std::string expandMacros(const std::string &code, std::string filename, const std::string &cfg, ErrorLogger *errorLogger, std::map<std::string, PreprocessorMacro *> &definitions);
+
+    /** @brief A directive, asm block or block of code lines in the file data given to getcode() */
+    struct Line {
+        enum Type { Code, Directive, Asm, UnterminatedAsm } type;
+
+        /** Code: position of the first line and end of the last line (without newline) in the file data */
+        std::string::size_type start, end;
+
+        /** number of lines */
+        unsigned int count;
+
+        /** Directive: the line. Asm: the code that replaces the asm block */
+        std::string text;
+
+        /** Directive: getdef() of the line */
+        std::string def, ndef;
+    };
+
+    /** split the file data into lines for getcode(), the result is stored in _lines */
+    void parseLines(const std::string &filedata);
+
+    /** the file data that _lines was created for */
+    std::string _linesData;
+
+    /** the lines of _linesData, see parseLines() */
+    std::vector<Line> _lines;
+
+    /** macros that getcode() has created, see expandMacros() */
+    std::map<std::string, PreprocessorMacro *> _macroDefinitions;
+
+    /** disabled assignment operator and copy constructor */
+    void operator=(const Preprocessor &);
+    Preprocessor(const Preprocessor &);
+
+    /** simplify condition with the tokenizer, for conditions that simplifyCondition() can't evaluate */
+    void simplifyConditionWithTokenizer(const std::map<std::string, std::string> &variables, std::string &condition, bool match);
+
+    /** results of simplifyCondition(), the key is the condition and the values of the macros used in it */
+    std::map<std::string, std::string> _conditionCache;
+
     Settings *_settings;
     ErrorLogger *_errorLogger;
 
@@ -24,7 +24,11 @@
 #include <set>
 
 Settings::Settings()
-    : _terminate(false),
+    : _enabled(0),
+      _terminate(false),
+      _fileDeadline(0),
+      _configDeadline(0),
+      _timerStartElapsed(0),
       debug(false), debugwarnings(false), debugFalsePositive(false),
       inconclusive(false), experimental(false),
       _errorsOnly(false),
@@ -37,6 +41,12 @@ Settings::Settings()
       _exitCode(0),
       _showtime(0),
       _maxConfigs(12),
+      _maxTemplateInstantiations(10000),
+      _maxTemplateTokens(1000000),
+      _maxTokens(0),
+      _maxMemory(0),
+      _maxTime(0),
+      _maxConfigTime(0),
       enforcedLang(None),
       reportProgress(false),
       checkConfiguration(false)
@@ -71,36 +81,15 @@ std::string Settings::addEnabled(const std::string &str)
         return addEnabled(str.substr(prevPos));
     }
 
-    bool handled = false;
-
-    static std::set<std::string> id;
-    if (id.empty()) {
-        id.insert("warning");
-        id.insert("style");
-        id.insert("performance");
-        id.insert("portability");
-        id.insert("information");
-        id.insert("missingInclude");
-        id.insert("unusedFunction");
-#ifndef NDEBUG
-        id.insert("internal");
-#endif
-    }
-
     if (str == "all") {
-        std::set<std::string>::const_iterator it;
-        for (it = id.begin(); it != id.end(); ++it) {
-            if (*it == "internal")
-                continue;
-
-            _enabled.insert(*it);
-        }
-    } else if (id.find(str) != id.end()) {
-        _enabled.insert(str);
+        // everything except "internal"
+        _enabled |= Warning | Style | Performance | Portability | Information | MissingInclude | UnusedFunction;
+    } else if (enabledCheck(str) != 0) {
+        _enabled |= enabledCheck(str);
         if (str == "information") {
-            _enabled.insert("missingInclude");
+            _enabled |= MissingInclude;
         }
-    } else if (!handled) {
+    } else {
         if (str.empty())
             return std::string("cppcheck: --enable parameter is empty");
         else
@@ -110,9 +99,32 @@ std::string Settings::addEnabled(const std::string &str)
     return std::string("");
 }
 
+unsigned int Settings::enabledCheck(const std::string &str)
+{
+    if (str == "warning")
+        return Warning;
+    if (str == "style")
+        return Style;
+    if (str == "performance")
+        return Performance;
+    if (str == "portability")
+        return Portability;
+    if (str == "information")
+        return Information;
+    if (str == "missingInclude")
+        return MissingInclude;
+    if (str == "unusedFunction")
+        return UnusedFunction;
+#ifndef NDEBUG
+    if (str == "internal")
+        return Internal;
+#endif
+    return 0;
+}
+
 bool Settings::isEnabled(const std::string &str) const
 {
-    return bool(_enabled.find(str) != _enabled.end());
+    return (_enabled & enabledCheck(str)) != 0;
 }
 
 
@@ -135,6 +147,33 @@ const std::string &Settings::append() const
     return _append;
 }
 
+void Settings::startFileTimer()
+{
+    _fileDeadline = _maxTime ? std::time(0) - _timerStartElapsed + _maxTime : 0;
+    _configDeadline = 0;
+}
+
+void Settings::startConfigTimer()
+{
+    _configDeadline = _maxConfigTime ? std::time(0) - _timerStartElapsed + _maxConfigTime : 0;
+}
+
+bool Settings::fileTimedOut() const
+{
+    return _fileDeadline != 0 && std::time(0) > _fileDeadline;
+}
+
+bool Settings::timedOut() const
+{
+    if (_fileDeadline == 0 && _configDeadline == 0)
+        return false;
+    // std::time() counts whole seconds, so only a later second is surely
+    // past the deadline
+    const std::time_t now = std::time(0);
+    return (_fileDeadline != 0 && now > _fileDeadline) ||
+           (_configDeadline != 0 && now > _configDeadline);
+}
+
 bool Settings::platform(PlatformType type)
 {
     switch (type) {
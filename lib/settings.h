@@ -23,6 +23,7 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <ctime>
 #include "config.h"
 #include "suppressions.h"
 #include "standards.h"
@@ -41,12 +42,21 @@ private:
     /** @brief Code to append in the checks */
     std::string _append;
 
-    /** @brief enable extra checks by id */
-    std::set<std::string> _enabled;
+    /** @brief enable extra checks by id, bitmask of EnabledCheck values */
+    unsigned int _enabled;
 
     /** @brief terminate checking */
     bool _terminate;
 
+    /** @brief when the current file and configuration run out of time, 0 if never */
+    std::time_t _fileDeadline;
+    std::time_t _configDeadline;
+
+    /** @brief seconds that have already passed when the timers are started */
+    unsigned int _timerStartElapsed;
+
+    friend class TestCppcheck;
+
 public:
     Settings();
 
@@ -79,9 +89,13 @@ public:
     /** @brief Is --verbose given? */
     bool _verbose;
 
-    /** @brief Request termination of checking */
-    void terminate() {
-        _terminate = true;
+    /**
+     * @brief Request termination of checking
+     * @param t false clears an earlier request, so the settings can be
+     * reused for new checks
+     */
+    void terminate(bool t = true) {
+        _terminate = t;
     }
 
     /** @brief termination requested? */
@@ -89,6 +103,21 @@ public:
         return _terminate;
     }
 
+    /** @brief Start the time budget of a new file (--max-time) */
+    void startFileTimer();
+
+    /** @brief Start the time budget of a new configuration (--max-config-time) */
+    void startConfigTimer();
+
+    /** @brief Has the current file run out of time? */
+    bool fileTimedOut() const;
+
+    /**
+     * @brief Has the current file or configuration run out of time? Long
+     * running loops poll this like terminated() and stop early.
+     */
+    bool timedOut() const;
+
     /** @brief Force checking the files with "too many" configurations (--force). */
     bool _force;
 
@@ -133,6 +162,43 @@ public:
         Default is 12. (--max-configs=N) */
     unsigned int _maxConfigs;
 
+    /** @brief Maximum number of template instantiations to expand in a file.
+        Default is 10000. (--max-template-instantiations=N) */
+    unsigned int _maxTemplateInstantiations;
+
+    /** @brief Maximum number of tokens that template expansion may add to
+        a file. Default is 1000000. (--max-template-tokens=N) */
+    unsigned int _maxTemplateTokens;
+
+    /** @brief Maximum number of tokens that may be alive while a
+        configuration is checked. 0 means no limit. (--max-tokens=N) */
+    unsigned int _maxTokens;
+
+    /** @brief Maximum estimated memory in megabytes that the tokens and
+        the symbol database of a configuration may use. 0 means no limit.
+        (--max-memory=N) */
+    unsigned int _maxMemory;
+
+    /** @brief Maximum wall-clock time in seconds for checking a file.
+        0 means no limit. (--max-time=N) */
+    unsigned int _maxTime;
+
+    /** @brief Maximum wall-clock time in seconds for checking a
+        configuration. 0 means no limit. (--max-config-time=N) */
+    unsigned int _maxConfigTime;
+
+    /** @brief Extra checks that can be enabled with --enable */
+    enum EnabledCheck {
+        Warning        = 1 << 0,
+        Style          = 1 << 1,
+        Performance    = 1 << 2,
+        Portability    = 1 << 3,
+        Information    = 1 << 4,
+        MissingInclude = 1 << 5,
+        UnusedFunction = 1 << 6,
+        Internal       = 1 << 7
+    };
+
     /**
      * @brief Returns true if given id is in the list of
      * enabled extra checks (--enable)
@@ -141,6 +207,24 @@ public:
      */
     bool isEnabled(const std::string &str) const;
 
+    /**
+     * @brief Returns true if the given extra check is enabled (--enable).
+     * This is cheaper than isEnabled(const std::string &) and should be
+     * used in the checks.
+     * @param check the extra check, e.g. Settings::Style
+     * @return true if the check is enabled.
+     */
+    bool isEnabled(EnabledCheck check) const {
+        return (_enabled & check) != 0;
+    }
+
+    /**
+     * @brief Get the extra check for an --enable id
+     * @param str id for the extra check, e.g. "style"
+     * @return the extra check, 0 if the id is unknown
+     */
+    static unsigned int enabledCheck(const std::string &str);
+
     /**
      * @brief Enable extra checks by id. See isEnabled()
      * @param str single id or list of id values to be enabled
@@ -166,31 +166,50 @@ std::string Suppressions::FileMatcher::addFile(const std::string &name, unsigned
             }
         }
         _globs[name][line] = false;
+        _globMatches.clear();
     } else if (name.empty()) {
         _globs["*"][0U] = false;
+        _globMatches.clear();
     } else {
         _files[Path::simplifyPath(name.c_str())][line] = false;
     }
     return "";
 }
 
+const std::vector<std::string> &Suppressions::FileMatcher::matchingGlobs(const std::string &file)
+{
+    std::map<std::string, std::vector<std::string> >::const_iterator cached = _globMatches.find(file);
+    if (cached != _globMatches.end())
+        return cached->second;
+
+    std::vector<std::string> &globs = _globMatches[file];
+    for (std::map<std::string, std::map<unsigned int, bool> >::const_iterator g = _globs.begin(); g != _globs.end(); ++g) {
+        if (match(g->first, file))
+            globs.push_back(g->first);
+    }
+    return globs;
+}
+
 bool Suppressions::FileMatcher::isSuppressed(const std::string &file, unsigned int line)
 {
     if (isSuppressedLocal(file, line))
         return true;
 
-    for (std::map<std::string, std::map<unsigned int, bool> >::iterator g = _globs.begin(); g != _globs.end(); ++g) {
-        if (match(g->first, file)) {
-            std::map<unsigned int, bool>::iterator l = g->second.find(0U);
-            if (l != g->second.end()) {
-                l->second = true;
-                return true;
-            }
-            l = g->second.find(line);
-            if (l != g->second.end()) {
-                l->second = true;
-                return true;
-            }
+    if (_globs.empty())
+        return false;
+
+    const std::vector<std::string> &globs = matchingGlobs(file);
+    for (std::vector<std::string>::const_iterator it = globs.begin(); it != globs.end(); ++it) {
+        std::map<unsigned int, bool> &lines = _globs[*it];
+        std::map<unsigned int, bool>::iterator l = lines.find(0U);
+        if (l != lines.end()) {
+            l->second = true;
+            return true;
+        }
+        l = lines.find(line);
+        if (l != lines.end()) {
+            l->second = true;
+            return true;
         }
     }
 
@@ -243,26 +262,38 @@ std::string Suppressions::addSuppression(const std::string &errorId, const std::
 
 bool Suppressions::isSuppressed(const std::string &errorId, const std::string &file, unsigned int line)
 {
-    if (errorId != "unmatchedSuppression" && _suppressions.find("*") != _suppressions.end())
-        if (_suppressions["*"].isSuppressed(file, line))
+    if (_suppressions.empty())
+        return false;
+
+    if (errorId != "unmatchedSuppression") {
+        std::map<std::string, FileMatcher>::iterator all = _suppressions.find("*");
+        if (all != _suppressions.end() && all->second.isSuppressed(file, line))
             return true;
+    }
 
-    if (_suppressions.find(errorId) == _suppressions.end())
+    std::map<std::string, FileMatcher>::iterator it = _suppressions.find(errorId);
+    if (it == _suppressions.end())
         return false;
 
-    return _suppressions[errorId].isSuppressed(file, line);
+    return it->second.isSuppressed(file, line);
 }
 
 bool Suppressions::isSuppressedLocal(const std::string &errorId, const std::string &file, unsigned int line)
 {
-    if (errorId != "unmatchedSuppression" && _suppressions.find("*") != _suppressions.end())
-        if (_suppressions["*"].isSuppressedLocal(file, line))
+    if (_suppressions.empty())
+        return false;
+
+    if (errorId != "unmatchedSuppression") {
+        std::map<std::string, FileMatcher>::iterator all = _suppressions.find("*");
+        if (all != _suppressions.end() && all->second.isSuppressedLocal(file, line))
             return true;
+    }
 
-    if (_suppressions.find(errorId) == _suppressions.end())
+    std::map<std::string, FileMatcher>::iterator it = _suppressions.find(errorId);
+    if (it == _suppressions.end())
         return false;
 
-    return _suppressions[errorId].isSuppressedLocal(file, line);
+    return it->second.isSuppressedLocal(file, line);
 }
 
 std::list<Suppressions::SuppressionEntry> Suppressions::getUnmatchedLocalSuppressions(const std::string &file) const
@@ -23,6 +23,7 @@
 #include <string>
 #include <istream>
 #include <map>
+#include <vector>
 #include "config.h"
 
 /// @addtogroup Core
@@ -39,6 +40,20 @@ private:
         /** @brief List of globs suppressed, bool flag indicates whether suppression matched. */
         std::map<std::string, std::map<unsigned int, bool> > _globs;
 
+        /**
+         * @brief Globs that match a given file name. Filled on demand so that
+         * the glob patterns are only matched once per file name. Cleared
+         * whenever a glob is added.
+         */
+        std::map<std::string, std::vector<std::string> > _globMatches;
+
+        /**
+         * @brief Get the globs that match the given file name (cached).
+         * @param file File name to check
+         * @return glob patterns matching the file name
+         */
+        const std::vector<std::string> &matchingGlobs(const std::string &file);
+
         /**
          * @brief Match a name against a glob pattern.
          * @param pattern The glob pattern to match.
@@ -1508,6 +1508,17 @@ void SymbolDatabase::debugMessage(const Token *tok, const std::string &msg) cons
     }
 }
 
+std::size_t SymbolDatabase::estimatedSize() const
+{
+    std::size_t size = sizeof(SymbolDatabase) + _variableList.capacity() * sizeof(const Variable *);
+    for (std::list<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
+        size += sizeof(Scope) + scope->varlist.size() * sizeof(Variable);
+        for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func)
+            size += sizeof(Function) + func->argumentList.size() * sizeof(Variable);
+    }
+    return size;
+}
+
 bool Variable::arrayDimensions(std::vector<Dimension> &dimensions, const Token *tok)
 {
     bool isArray = false;
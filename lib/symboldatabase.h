@@ -643,6 +643,9 @@ public:
      */
     void debugMessage(const Token *tok, const std::string &msg) const;
 
+    /** @brief Estimated number of bytes used by the scopes, functions and variables */
+    std::size_t estimatedSize() const;
+
     void printOut(const char * title = NULL) const;
     void printVariable(const Variable *var, const char *indent) const;
 
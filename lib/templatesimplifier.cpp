@@ -30,6 +30,7 @@
 #include <vector>
 #include <string>
 #include <cassert>
+#include <limits>
 
 //---------------------------------------------------------------------------
 
@@ -583,102 +584,134 @@ int TemplateSimplifier::getTemplateNamePosition(const Token *tok)
 }
 
 
-void TemplateSimplifier::expandTemplate(
+const Token *TemplateSimplifier::expandTemplatePart(
     TokenList& tokenlist,
     const Token *tok,
+    const Token *tok3,
     const std::string &name,
     std::vector<const Token *> &typeParametersInDeclaration,
     const std::string &newName,
     std::vector<const Token *> &typesUsedInTemplateInstantiation,
     std::list<Token *> &templateInstantiations)
 {
-    for (const Token *tok3 = tokenlist.front(); tok3; tok3 = tok3->next()) {
-        if (tok3->str() == "{" || tok3->str() == "(")
-            tok3 = tok3->link();
+    // Start of template..
+    if (tok3 == tok) {
+        tok3 = tok3->next();
+    }
 
-        // Start of template..
-        if (tok3 == tok) {
+    // member function implemented outside class definition
+    else {
+        tokenlist.addtoken(newName.c_str(), tok3->linenr(), tok3->fileIndex());
+        while (tok3->str() != "::")
             tok3 = tok3->next();
-        }
+    }
 
-        // member function implemented outside class definition
-        else if (TemplateSimplifier::instantiateMatch(tok3, name, typeParametersInDeclaration.size(), ":: ~| %var% (")) {
-            tokenlist.addtoken(newName.c_str(), tok3->linenr(), tok3->fileIndex());
-            while (tok3->str() != "::")
-                tok3 = tok3->next();
+    int indentlevel = 0;
+    std::stack<Token *> brackets; // holds "(", "[" and "{" tokens
+
+    for (; tok3; tok3 = tok3->next()) {
+        if (tok3->isName()) {
+            // search for this token in the type vector
+            unsigned int itype = 0;
+            while (itype < typeParametersInDeclaration.size() && typeParametersInDeclaration[itype]->str() != tok3->str())
+                ++itype;
+
+            // replace type with given type..
+            if (itype < typeParametersInDeclaration.size()) {
+                for (const Token *typetok = typesUsedInTemplateInstantiation[itype];
+                     typetok && !Token::Match(typetok, "[,>]");
+                     typetok = typetok->next()) {
+                    tokenlist.addtoken(typetok, tok3->linenr(), tok3->fileIndex());
+                }
+                continue;
+            }
         }
 
-        // not part of template.. go on to next token
-        else
+        // replace name..
+        if (Token::Match(tok3, (name + " !!<").c_str())) {
+            tokenlist.addtoken(newName.c_str(), tok3->linenr(), tok3->fileIndex());
             continue;
+        }
 
-        int indentlevel = 0;
-        std::stack<Token *> brackets; // holds "(", "[" and "{" tokens
-
-        for (; tok3; tok3 = tok3->next()) {
-            if (tok3->isName()) {
-                // search for this token in the type vector
-                unsigned int itype = 0;
-                while (itype < typeParametersInDeclaration.size() && typeParametersInDeclaration[itype]->str() != tok3->str())
-                    ++itype;
-
-                // replace type with given type..
-                if (itype < typeParametersInDeclaration.size()) {
-                    for (const Token *typetok = typesUsedInTemplateInstantiation[itype];
-                         typetok && !Token::Match(typetok, "[,>]");
-                         typetok = typetok->next()) {
-                        tokenlist.addtoken(typetok, tok3->linenr(), tok3->fileIndex());
-                    }
-                    continue;
-                }
-            }
+        // copy
+        tokenlist.addtoken(tok3, tok3->linenr(), tok3->fileIndex());
+        if (Token::Match(tok3, "%type% <")) {
+            //if (!Token::simpleMatch(tok3, (name + " <").c_str()))
+            //done = false;
+            templateInstantiations.push_back(tokenlist.back());
+        }
 
-            // replace name..
-            if (Token::Match(tok3, (name + " !!<").c_str())) {
-                tokenlist.addtoken(newName.c_str(), tok3->linenr(), tok3->fileIndex());
-                continue;
+        // link() newly tokens manually
+        else if (tok3->str() == "{") {
+            brackets.push(tokenlist.back());
+            indentlevel++;
+        } else if (tok3->str() == "(") {
+            brackets.push(tokenlist.back());
+        } else if (tok3->str() == "[") {
+            brackets.push(tokenlist.back());
+        } else if (tok3->str() == "}") {
+            assert(brackets.empty() == false && brackets.top()->str() == "{");
+            Token::createMutualLinks(brackets.top(), tokenlist.back());
+            brackets.pop();
+            if (indentlevel <= 1 && brackets.empty()) {
+                // there is a bug if indentlevel is 0
+                // the "}" token should only be added if indentlevel is 1 but I add it always intentionally
+                // if indentlevel ever becomes 0, cppcheck will write:
+                // ### Error: Invalid number of character {
+                break;
             }
+            --indentlevel;
+        } else if (tok3->str() == ")") {
+            assert(brackets.empty() == false && brackets.top()->str() == "(");
+            Token::createMutualLinks(brackets.top(), tokenlist.back());
+            brackets.pop();
+        } else if (tok3->str() == "]") {
+            assert(brackets.empty() == false && brackets.top()->str() == "[");
+            Token::createMutualLinks(brackets.top(), tokenlist.back());
+            brackets.pop();
+        }
+    }
 
-            // copy
-            tokenlist.addtoken(tok3, tok3->linenr(), tok3->fileIndex());
-            if (Token::Match(tok3, "%type% <")) {
-                //if (!Token::simpleMatch(tok3, (name + " <").c_str()))
-                //done = false;
-                templateInstantiations.push_back(tokenlist.back());
-            }
+    assert(brackets.empty());
+    return tok3;
+}
 
-            // link() newly tokens manually
-            else if (tok3->str() == "{") {
-                brackets.push(tokenlist.back());
-                indentlevel++;
-            } else if (tok3->str() == "(") {
-                brackets.push(tokenlist.back());
-            } else if (tok3->str() == "[") {
-                brackets.push(tokenlist.back());
-            } else if (tok3->str() == "}") {
-                assert(brackets.empty() == false && brackets.top()->str() == "{");
-                Token::createMutualLinks(brackets.top(), tokenlist.back());
-                brackets.pop();
-                if (indentlevel <= 1 && brackets.empty()) {
-                    // there is a bug if indentlevel is 0
-                    // the "}" token should only be added if indentlevel is 1 but I add it always intentionally
-                    // if indentlevel ever becomes 0, cppcheck will write:
-                    // ### Error: Invalid number of character {
-                    break;
-                }
-                --indentlevel;
-            } else if (tok3->str() == ")") {
-                assert(brackets.empty() == false && brackets.top()->str() == "(");
-                Token::createMutualLinks(brackets.top(), tokenlist.back());
-                brackets.pop();
-            } else if (tok3->str() == "]") {
-                assert(brackets.empty() == false && brackets.top()->str() == "[");
-                Token::createMutualLinks(brackets.top(), tokenlist.back());
-                brackets.pop();
-            }
+void TemplateSimplifier::expandTemplate(
+    TokenList& tokenlist,
+    const Token *tok,
+    const std::string &name,
+    std::vector<const Token *> &typeParametersInDeclaration,
+    const std::string &newName,
+    std::vector<const Token *> &typesUsedInTemplateInstantiation,
+    std::list<Token *> &templateInstantiations,
+    std::list<const Token *> &templateParts)
+{
+    // the parts located by a previous expansion are still in place?
+    for (std::list<const Token *>::const_iterator it = templateParts.begin(); it != templateParts.end(); ++it) {
+        if (*it != tok && !TemplateSimplifier::instantiateMatch(*it, name, typeParametersInDeclaration.size(), ":: ~| %var% (")) {
+            templateParts.clear();
+            break;
         }
+    }
 
-        assert(brackets.empty());
+    if (!templateParts.empty()) {
+        for (std::list<const Token *>::const_iterator it = templateParts.begin(); it != templateParts.end(); ++it)
+            expandTemplatePart(tokenlist, tok, *it, name, typeParametersInDeclaration, newName, typesUsedInTemplateInstantiation, templateInstantiations);
+        return;
+    }
+
+    for (const Token *tok3 = tokenlist.front(); tok3; tok3 = tok3->next()) {
+        if (tok3->str() == "{" || tok3->str() == "(")
+            tok3 = tok3->link();
+
+        // Start of template or member function implemented outside class definition..
+        if (tok3 == tok ||
+            TemplateSimplifier::instantiateMatch(tok3, name, typeParametersInDeclaration.size(), ":: ~| %var% (")) {
+            templateParts.push_back(tok3);
+            tok3 = expandTemplatePart(tokenlist, tok, tok3, name, typeParametersInDeclaration, newName, typesUsedInTemplateInstantiation, templateInstantiations);
+            if (!tok3)
+                break;
+        }
     }
 }
 
@@ -712,6 +745,23 @@ static bool isLowerEqualThanMulDiv(const Token* lower)
 }
 
 
+/** @brief compare two integers, "1" if "op1 cmp op2" is true and "0" otherwise */
+template<class T>
+static std::string compareNumbers(T op1, const std::string &cmp, T op2)
+{
+    if (cmp == "==")
+        return (op1 == op2) ? "1" : "0";
+    if (cmp == "!=")
+        return (op1 != op2) ? "1" : "0";
+    if (cmp == "<=")
+        return (op1 <= op2) ? "1" : "0";
+    if (cmp == ">=")
+        return (op1 >= op2) ? "1" : "0";
+    if (cmp == "<")
+        return (op1 < op2) ? "1" : "0";
+    return (op1 > op2) ? "1" : "0";
+}
+
 bool TemplateSimplifier::simplifyNumericCalculations(Token *tok)
 {
     bool ret = false;
@@ -746,7 +796,10 @@ bool TemplateSimplifier::simplifyNumericCalculations(Token *tok)
             if (cop == '&' || cop == '|' || cop == '^')
                 result = MathLib::calculate(tok->str(), tok->strAt(2), cop);
             else if (cop == '<') {
-                if (tok->previous()->str() != "<<" && rightInt > 0) // Ensure that its not a shift operator as used for streams
+                // Ensure that its not a shift operator as used for streams and
+                // that no bits are shifted out
+                if (tok->previous()->str() != "<<" && rightInt > 0 && rightInt < 63 &&
+                    leftInt >= 0 && leftInt <= (std::numeric_limits<MathLib::bigint>::max() >> rightInt))
                     result = MathLib::longToString(leftInt << rightInt);
             } else if (rightInt > 0)
                 result = MathLib::longToString(leftInt >> rightInt);
@@ -757,6 +810,10 @@ bool TemplateSimplifier::simplifyNumericCalculations(Token *tok)
                 tok->deleteNext(2);
                 continue;
             }
+
+            // Shifts that can't be evaluated are kept, "%num% << 0" is simplified below
+            if (rightInt != 0)
+                continue;
         }
 
         else if (Token::Match(tok->previous(), "- %num% - %num%"))
@@ -927,24 +984,17 @@ bool TemplateSimplifier::simplifyCalculations(Token *_tokens)
                 MathLib::isInt(tok->str()) &&
                 MathLib::isInt(tok->strAt(2))) {
                 if (Token::Match(tok->previous(), "(|&&|%oror%") && Token::Match(tok->tokAt(3), ")|&&|%oror%")) {
-                    const MathLib::bigint op1(MathLib::toLongNumber(tok->str()));
                     const std::string &cmp(tok->next()->str());
-                    const MathLib::bigint op2(MathLib::toLongNumber(tok->strAt(2)));
 
                     std::string result;
 
-                    if (cmp == "==")
-                        result = (op1 == op2) ? "1" : "0";
-                    else if (cmp == "!=")
-                        result = (op1 != op2) ? "1" : "0";
-                    else if (cmp == "<=")
-                        result = (op1 <= op2) ? "1" : "0";
-                    else if (cmp == ">=")
-                        result = (op1 >= op2) ? "1" : "0";
-                    else if (cmp == "<")
-                        result = (op1 < op2) ? "1" : "0";
-                    else if (cmp == ">")
-                        result = (op1 > op2) ? "1" : "0";
+                    // If one operand is unsigned the other one is converted to unsigned
+                    if (tok->isUnsigned() || tok->str().find_first_of("uU") != std::string::npos ||
+                        tok->tokAt(2)->isUnsigned() || tok->strAt(2).find_first_of("uU") != std::string::npos)
+                        result = compareNumbers(static_cast<unsigned long long>(MathLib::toLongNumber(tok->str())), cmp,
+                                                static_cast<unsigned long long>(MathLib::toLongNumber(tok->strAt(2))));
+                    else
+                        result = compareNumbers(MathLib::toLongNumber(tok->str()), cmp, MathLib::toLongNumber(tok->strAt(2)));
 
                     tok->str(result);
                     tok->deleteNext(2);
@@ -972,12 +1022,11 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
     const Settings *_settings,
     const Token *tok,
     std::list<Token *> &templateInstantiations,
-    std::set<std::string> &expandedtemplates)
+    std::list<Token *> &newInstantiations,
+    std::set<std::string> &expandedtemplates,
+    unsigned int &instantiationCount,
+    unsigned int &tokenCount)
 {
-    // this variable is not used at the moment. The intention was to
-    // allow continuous instantiations until all templates has been expanded
-    //bool done = false;
-
     // Contains tokens such as "T"
     std::vector<const Token *> typeParametersInDeclaration;
     for (tok = tok->tokAt(2); tok && tok->str() != ">"; tok = tok->next()) {
@@ -1005,23 +1054,13 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
 
     const bool isfunc(tok->strAt(namepos + 1) == "(");
 
-    // locate template usage..
-    std::string::size_type amountOftemplateInstantiations = templateInstantiations.size();
-    unsigned int recursiveCount = 0;
+    // the template and its member functions implemented outside the class
+    // definition are located once and reused for all instantiations
+    std::list<const Token *> templateParts;
 
     bool instantiated = false;
 
     for (std::list<Token *>::const_iterator iter2 = templateInstantiations.begin(); iter2 != templateInstantiations.end(); ++iter2) {
-        if (amountOftemplateInstantiations != templateInstantiations.size()) {
-            amountOftemplateInstantiations = templateInstantiations.size();
-            simplifyCalculations(tokenlist.front());
-            ++recursiveCount;
-            if (recursiveCount > 100) {
-                // bail out..
-                break;
-            }
-        }
-
         Token * const tok2 = *iter2;
         if (tok2->str() != name)
             continue;
@@ -1081,8 +1120,22 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
         const std::string newName(name + "<" + typeForNewName + ">");
 
         if (expandedtemplates.find(newName) == expandedtemplates.end()) {
+            if (_settings->timedOut())
+                break;
+
+            if (instantiationCount >= _settings->_maxTemplateInstantiations ||
+                tokenCount >= _settings->_maxTemplateTokens) {
+                if (_settings->isEnabled(Settings::Information))
+                    instantiationLimitError(tokenlist, errorlogger, tok2, newName, _settings);
+                break;
+            }
+
             expandedtemplates.insert(newName);
-            TemplateSimplifier::expandTemplate(tokenlist, tok,name,typeParametersInDeclaration,newName,typesUsedInTemplateInstantiation,templateInstantiations);
+            const Token * const last = tokenlist.back();
+            TemplateSimplifier::expandTemplate(tokenlist, tok,name,typeParametersInDeclaration,newName,typesUsedInTemplateInstantiation,newInstantiations,templateParts);
+            for (const Token *tok3 = last->next(); tok3; tok3 = tok3->next())
+                ++tokenCount;
+            ++instantiationCount;
             instantiated = true;
         }
 
@@ -1121,9 +1174,14 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
                 // Foo < int >  =>  Foo<int>
                 if (tok5 && tok5->str() == ">" && typeCountInInstantiation == typesUsedInTemplateInstantiation.size()) {
                     tok4->str(newName);
-                    for (Token *tok6 = tok4->next(); tok6 != tok5; tok6 = tok6->next()) {
-                        if (tok6->isName())
+                    for (Token *tok6 = tok4->next(); tok6 != tok5->next(); tok6 = tok6->next()) {
+                        if (tok6->isName()) {
                             templateInstantiations.remove(tok6);
+                            newInstantiations.remove(tok6);
+                        }
+                        // the parts are located again if one of them is erased
+                        if (std::find(templateParts.begin(), templateParts.end(), tok6) != templateParts.end())
+                            templateParts.clear();
                     }
                     removeTokens.push_back(std::pair<Token*,Token*>(tok4, tok5->next()));
                 }
@@ -1143,6 +1201,29 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
     return instantiated;
 }
 
+void TemplateSimplifier::instantiationLimitError(
+    const TokenList& tokenlist,
+    ErrorLogger& errorlogger,
+    const Token *tok,
+    const std::string &name,
+    const Settings *_settings)
+{
+    std::list<const Token *> callstack;
+    if (tok)
+        callstack.push_back(tok);
+
+    std::ostringstream msg;
+    msg << "Template instantiation '" << name << "' is not expanded, the limit of "
+        << _settings->_maxTemplateInstantiations << " instantiations or "
+        << _settings->_maxTemplateTokens << " tokens is reached.\n"
+        << "Template instantiation '" << name << "' is not expanded, the limit of "
+        << _settings->_maxTemplateInstantiations << " instantiations or "
+        << _settings->_maxTemplateTokens << " tokens is reached. The checking "
+        << "continues without it. The limits are set with "
+        << "--max-template-instantiations and --max-template-tokens.";
+    errorlogger.reportErr(ErrorLogger::ErrorMessage(callstack, &tokenlist, Severity::information, "templateInstantiationLimit", msg.str(), false));
+}
+
 
 void TemplateSimplifier::simplifyTemplates(
     TokenList& tokenlist,
@@ -1185,29 +1266,48 @@ void TemplateSimplifier::simplifyTemplates(
     // Template arguments with default values
     TemplateSimplifier::useDefaultArgumentValues(templates, templateInstantiations);
 
-    // expand templates
-    //bool done = false;
-    //while (!done)
-    {
-        //done = true;
-        std::list<Token *> templates2;
+    // expand templates. Each pass handles the instantiations found in the
+    // code that the previous pass added. The number of passes is the depth
+    // of nested instantiations, it is limited because the recursion in
+    // "template<int N> struct F { F<N+1> x; };" never ends.
+    unsigned int instantiationCount = 0;
+    unsigned int tokenCount = 0;
+    std::set<Token *> instantiatedTemplates;
+    for (unsigned int depth = 0; depth <= 100 && !templateInstantiations.empty(); ++depth) {
+        // the tokenizer bails out after this when checking has run out of time
+        if (_settings->timedOut())
+            break;
+
+        Token * const lastBeforePass = tokenlist.back();
+        std::list<Token *> newInstantiations;
         for (std::list<Token *>::reverse_iterator iter1 = templates.rbegin(); iter1 != templates.rend(); ++iter1) {
+            if (_settings->timedOut())
+                break;
+
             bool instantiated = TemplateSimplifier::simplifyTemplateInstantiations(tokenlist,
                                 errorlogger,
                                 _settings,
                                 *iter1,
                                 templateInstantiations,
-                                expandedtemplates);
+                                newInstantiations,
+                                expandedtemplates,
+                                instantiationCount,
+                                tokenCount);
             if (instantiated)
-                templates2.push_back(*iter1);
+                instantiatedTemplates.insert(*iter1);
         }
 
-        for (std::list<Token *>::iterator it = templates2.begin(); it != templates2.end(); ++it) {
-            std::list<Token *>::iterator it1 = std::find(templates.begin(), templates.end(), *it);
-            if (it1 != templates.end()) {
-                templates.erase(it1);
-                removeTemplate(*it);
-            }
-        }
+        // simplify calculations such as "N+1" in the added code
+        if (lastBeforePass != tokenlist.back())
+            simplifyCalculations(lastBeforePass->next());
+
+        templateInstantiations.swap(newInstantiations);
+    }
+
+    // remove the instantiated templates, the last one first since removing
+    // a template can move the tokens that follow it
+    for (std::list<Token *>::reverse_iterator iter1 = templates.rbegin(); iter1 != templates.rend(); ++iter1) {
+        if (instantiatedTemplates.find(*iter1) != instantiatedTemplates.end())
+            removeTemplate(*iter1);
     }
 }
@@ -108,15 +108,39 @@ public:
      */
     static int getTemplateNamePosition(const Token *tok);
 
-    static void expandTemplate(
+    /**
+     * Copy one part of a template to the end of the token list
+     * @param tokenlist token list
+     * @param tok the ">" token of the template declaration
+     * @param tok3 the template declaration or a member function implemented outside the class definition
+     * @return the last token that was copied
+     */
+    static const Token *expandTemplatePart(
         TokenList& tokenlist,
         const Token *tok,
+        const Token *tok3,
         const std::string &name,
         std::vector<const Token *> &typeParametersInDeclaration,
         const std::string &newName,
         std::vector<const Token *> &typesUsedInTemplateInstantiation,
         std::list<Token *> &templateInstantiations);
 
+    /**
+     * Expand a template instantiation to the end of the token list
+     * @param templateParts the template declaration and its member functions
+     * implemented outside the class definition. Located by the first expansion
+     * when empty and reused by the following ones.
+     */
+    static void expandTemplate(
+        TokenList& tokenlist,
+        const Token *tok,
+        const std::string &name,
+        std::vector<const Token *> &typeParametersInDeclaration,
+        const std::string &newName,
+        std::vector<const Token *> &typesUsedInTemplateInstantiation,
+        std::list<Token *> &templateInstantiations,
+        std::list<const Token *> &templateParts);
+
     /**
      * Simplify templates : expand all instantiations for a template
      * @todo It seems that inner templates should be instantiated recursively
@@ -125,7 +149,10 @@ public:
      * @param _settings settings
      * @param tok token where the template declaration begins
      * @param templateInstantiations a list of template usages (not necessarily just for this template)
+     * @param newInstantiations the template usages in the expanded code are added to this list
      * @param expandedtemplates all templates that has been expanded so far. The full names are stored.
+     * @param instantiationCount number of instantiations expanded in the file so far
+     * @param tokenCount number of tokens added by the expansions so far
      * @return true if the template was instantiated
      */
     static bool simplifyTemplateInstantiations(
@@ -134,7 +161,21 @@ public:
         const Settings *_settings,
         const Token *tok,
         std::list<Token *> &templateInstantiations,
-        std::set<std::string> &expandedtemplates);
+        std::list<Token *> &newInstantiations,
+        std::set<std::string> &expandedtemplates,
+        unsigned int &instantiationCount,
+        unsigned int &tokenCount);
+
+    /**
+     * Report that an instantiation is not expanded because the limits
+     * --max-template-instantiations or --max-template-tokens are reached
+     */
+    static void instantiationLimitError(
+        const TokenList& tokenlist,
+        ErrorLogger& errorlogger,
+        const Token *tok,
+        const std::string &name,
+        const Settings *_settings);
 
     /**
      * Simplify templates
@@ -50,6 +50,12 @@ void TimerResults::ShowResults() const
 
     const double secOverall = overallData.seconds();
     std::cout << "Overall time: " << secOverall << "s" << std::endl;
+
+    for (std::map<std::string, unsigned long>::const_iterator it = _counts.begin(); it != _counts.end(); ++it)
+        std::cout << it->first << ": " << it->second << std::endl;
+
+    for (std::map<std::string, unsigned long>::const_iterator it = _maxima.begin(); it != _maxima.end(); ++it)
+        std::cout << it->first << ": " << it->second << " (max)" << std::endl;
 }
 
 void TimerResults::AddResults(const std::string& str, std::clock_t clocks)
@@ -58,6 +64,18 @@ void TimerResults::AddResults(const std::string& str, std::clock_t clocks)
     _results[str]._numberOfResults++;
 }
 
+void TimerResults::AddCount(const std::string& str, unsigned long count)
+{
+    _counts[str] += count;
+}
+
+void TimerResults::AddMaximum(const std::string& str, unsigned long value)
+{
+    unsigned long &maximum = _maxima[str];
+    if (value > maximum)
+        maximum = value;
+}
+
 Timer::Timer(const std::string& str, unsigned int showtimeMode, TimerResultsIntf* timerResults)
     : _str(str)
     , _timerResults(timerResults)
@@ -36,6 +36,8 @@ public:
     virtual ~TimerResultsIntf() { }
 
     virtual void AddResults(const std::string& str, std::clock_t clocks) = 0;
+    virtual void AddCount(const std::string& str, unsigned long count) = 0;
+    virtual void AddMaximum(const std::string& str, unsigned long value) = 0;
 };
 
 struct TimerResultsData {
@@ -60,9 +62,13 @@ public:
 
     void ShowResults() const;
     virtual void AddResults(const std::string& str, std::clock_t clocks);
+    virtual void AddCount(const std::string& str, unsigned long count);
+    virtual void AddMaximum(const std::string& str, unsigned long value);
 
 private:
     std::map<std::string, struct TimerResultsData> _results;
+    std::map<std::string, unsigned long> _counts;
+    std::map<std::string, unsigned long> _maxima;
 };
 
 class CPPCHECKLIB Timer {
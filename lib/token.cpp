@@ -28,7 +28,7 @@
 #include <sstream>
 #include <map>
 
-Token::Token(Token **t) :
+Token::Token(TokensBack *t) :
     tokensBack(t),
     _next(0),
     _previous(0),
@@ -53,11 +53,17 @@ Token::Token(Token **t) :
     _astOperand2(NULL),
     _astParent(NULL)
 {
+    for (TokensBack *counters = tokensBack; counters; counters = counters->parent) {
+        ++counters->allocated;
+        if (++counters->live > counters->peakLive)
+            counters->peakLive = counters->live;
+    }
 }
 
 Token::~Token()
 {
-
+    for (TokensBack *counters = tokensBack; counters; counters = counters->parent)
+        --counters->live;
 }
 
 void Token::update_property_info()
@@ -180,7 +186,7 @@ void Token::deleteNext(unsigned long index)
     if (_next)
         _next->previous(this);
     else if (tokensBack)
-        *tokensBack = this;
+        tokensBack->back = this;
 }
 
 void Token::deleteThis()
@@ -257,10 +263,10 @@ void Token::replace(Token *replaceThis, Token *start, Token *end)
     start->previous(replaceThis->previous());
     end->next(replaceThis->next());
 
-    if (end->tokensBack && *(end->tokensBack) == end) {
+    if (end->tokensBack && end->tokensBack->back == end) {
         while (end->next())
             end = end->next();
-        *(end->tokensBack) = end;
+        end->tokensBack->back = end;
     }
 
     // Update _progressValue, fileIndex and linenr
@@ -925,7 +931,7 @@ void Token::insertToken(const std::string &tokenStr, bool prepend)
                 newToken->next(this->next());
                 newToken->next()->previous(newToken);
             } else if (tokensBack) {
-                *tokensBack = newToken;
+                tokensBack->back = newToken;
             }
             this->next(newToken);
             newToken->previous(this);
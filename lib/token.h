@@ -27,10 +27,38 @@
 class Scope;
 class Function;
 class Variable;
+class Token;
 
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief The last token of a token list and the number of tokens that the
+ * list has created. The tokens of the list share it, so each token list
+ * counts its own tokens.
+ */
+struct TokensBack {
+    TokensBack() : back(0), allocated(0), live(0), peakLive(0), parent(0) { }
+
+    /** @brief last token of the list */
+    Token *back;
+
+    /** @brief number of tokens created */
+    std::size_t allocated;
+
+    /** @brief number of tokens alive */
+    std::size_t live;
+
+    /** @brief highest number of tokens alive at once */
+    std::size_t peakLive;
+
+    /**
+     * @brief counters of the list that this list is a copy of, or 0. The
+     * tokens are counted there too, so the copies count towards its limits.
+     */
+    TokensBack *parent;
+};
+
 /**
  * @brief The token list that the TokenList generates is a linked-list of this class.
  *
@@ -43,7 +71,7 @@ class Variable;
  */
 class CPPCHECKLIB Token {
 private:
-    Token **tokensBack;
+    TokensBack *tokensBack;
 
     // Not implemented..
     Token();
@@ -60,7 +88,7 @@ public:
         eNone
     };
 
-    explicit Token(Token **tokensBack);
+    explicit Token(TokensBack *tokensBack);
     ~Token();
 
     void str(const std::string &s);
@@ -574,7 +602,6 @@ private:
      */
     static int firstWordLen(const char *str);
 
-
     Token *_next;
     Token *_previous;
     Token *_link;
@@ -28,6 +28,7 @@
 #include "timer.h"
 
 #include <cstring>
+#include <iostream>
 #include <sstream>
 #include <cassert>
 #include <cctype>
@@ -42,7 +43,8 @@ Tokenizer::Tokenizer() :
     _symbolDatabase(0),
     _varId(0),
     _codeWithTemplates(false), //is there any templates?
-    m_timerResults(NULL)
+    m_timerResults(NULL),
+    _peakSymbolDatabaseSize(0)
 {
 }
 
@@ -53,7 +55,8 @@ Tokenizer::Tokenizer(const Settings *settings, ErrorLogger *errorLogger) :
     _symbolDatabase(0),
     _varId(0),
     _codeWithTemplates(false), //is there any templates?
-    m_timerResults(NULL)
+    m_timerResults(NULL),
+    _peakSymbolDatabaseSize(0)
 {
     // make sure settings are specified
     assert(_settings);
@@ -136,7 +139,7 @@ Token *Tokenizer::copyTokens(Token *dest, const Token *first, const Token *last,
 
 void Tokenizer::duplicateTypedefError(const Token *tok1, const Token *tok2, const std::string &type) const
 {
-    if (tok1 && !(_settings->isEnabled("style") && _settings->inconclusive))
+    if (tok1 && !(_settings->isEnabled(Settings::Style) && _settings->inconclusive))
         return;
 
     std::list<const Token*> locationList;
@@ -150,7 +153,7 @@ void Tokenizer::duplicateTypedefError(const Token *tok1, const Token *tok2, cons
 
 void Tokenizer::duplicateDeclarationError(const Token *tok1, const Token *tok2, const std::string &type) const
 {
-    if (tok1 && !(_settings->isEnabled("style")))
+    if (tok1 && !(_settings->isEnabled(Settings::Style)))
         return;
 
     std::list<const Token*> locationList;
@@ -498,8 +501,92 @@ static Token *processFunc(Token *tok2, bool inOperator)
     return tok2;
 }
 
+namespace {
+    /** @brief Work done by simplifyTypedef, reported with --showtime */
+    class TypedefCounters {
+    public:
+        TypedefCounters(unsigned int showtimeMode, TimerResultsIntf *timerResults)
+            : typedefs(0), tokensVisited(0), _showtimeMode(showtimeMode), _timerResults(timerResults) {
+        }
+
+        ~TypedefCounters() {
+            report("Tokenizer::simplifyTypedef::typedefs", typedefs);
+            report("Tokenizer::simplifyTypedef::tokensVisited", tokensVisited);
+        }
+
+        unsigned long typedefs;
+        unsigned long tokensVisited;
+
+    private:
+        void report(const std::string &str, unsigned long count) const {
+            if (_showtimeMode == SHOWTIME_FILE)
+                std::cout << str << ": " << count << std::endl;
+            else if (_showtimeMode != SHOWTIME_NONE && _timerResults)
+                _timerResults->AddCount(str, count);
+        }
+
+        const unsigned int _showtimeMode;
+        TimerResultsIntf *_timerResults;
+    };
+}
+
+/**
+ * Index of the last occurrence of each name, as a progress value. Progress
+ * values never decrease along the token list, so a typedef or enum only
+ * needs to be looked for up to the last occurrence of its names.
+ */
+typedef std::map<std::string, unsigned int> OccurrenceIndex;
+
+static void indexOccurrences(OccurrenceIndex &index, const Token *front)
+{
+    for (const Token *tok = front; tok; tok = tok->next()) {
+        if (tok->isName())
+            index[tok->str()] = tok->progressValue();
+    }
+}
+
+static void addOccurrence(OccurrenceIndex &index, const std::string &name, unsigned int progress)
+{
+    OccurrenceIndex::iterator it = index.find(name);
+    if (it == index.end())
+        index[name] = progress;
+    else if (it->second < progress)
+        it->second = progress;
+}
+
+/** Record that the names in [start,end] may have been copied to the uses up to the given progress value */
+static void addOccurrences(OccurrenceIndex &index, const Token *start, const Token *end, unsigned int progress)
+{
+    for (const Token *tok = start; tok && tok != end->next(); tok = tok->next()) {
+        if (tok->isName())
+            addOccurrence(index, tok->str(), progress);
+    }
+}
+
+/**
+ * Does the name occur at or after the given token?
+ * @param progress raised to the progress value of the last occurrence
+ */
+static bool occursAfter(const OccurrenceIndex &index, const std::string &name, const Token *tok, unsigned int *progress)
+{
+    const OccurrenceIndex::const_iterator it = index.find(name);
+    if (it == index.end() || it->second < tok->progressValue())
+        return false;
+    if (*progress < it->second)
+        *progress = it->second;
+    return true;
+}
+
 void Tokenizer::simplifyTypedef()
 {
+    if (!Token::findsimplematch(list.front(), "typedef"))
+        return;
+
+    TypedefCounters counters(m_timerResults ? _settings->_showtime : (unsigned int)SHOWTIME_NONE, m_timerResults);
+
+    OccurrenceIndex lastOccurrence;
+    indexOccurrences(lastOccurrence, list.front());
+
     std::vector<Space> spaceInfo;
     bool isNamespace = false;
     std::string className;
@@ -951,7 +1038,14 @@ void Tokenizer::simplifyTypedef()
             bool globalScope = false;
             std::size_t classLevel = spaceInfo.size();
 
-            for (Token *tok2 = tok; tok2; tok2 = tok2->next()) {
+            // all uses lie at or before the last occurrence of the name
+            unsigned int lastProgress = 0;
+            const bool used = occursAfter(lastOccurrence, typeName->str(), tok, &lastProgress);
+            ++counters.typedefs;
+
+            for (Token *tok2 = used ? tok : 0; tok2 && tok2->progressValue() <= lastProgress; tok2 = tok2->next()) {
+                ++counters.tokensVisited;
+
                 // check for end of scope
                 if (tok2->str() == "}") {
                     // check for end of member function
@@ -1410,6 +1504,13 @@ void Tokenizer::simplifyTypedef()
                 }
             }
 
+            // the typedef and the qualifications may have been copied to the uses
+            if (used) {
+                addOccurrences(lastOccurrence, typeDef, tok, lastProgress);
+                for (std::size_t i = 0; i < spaceInfo.size(); ++i)
+                    addOccurrence(lastOccurrence, spaceInfo[i].className, lastProgress);
+            }
+
             if (tok->str() == ";")
                 done = true;
             else if (tok->str() == ",") {
@@ -1555,6 +1656,15 @@ void Tokenizer::simplifyMulAndParens()
 bool Tokenizer::tokenize(std::istream &code,
                          const char FileName[],
                          const std::string &configuration)
+{
+    std::ostringstream ostr;
+    ostr << code.rdbuf();
+    return tokenize(ostr.str(), FileName, configuration);
+}
+
+bool Tokenizer::tokenize(const std::string &code,
+                         const char FileName[],
+                         const std::string &configuration)
 {
     // make sure settings specified
     assert(_settings);
@@ -1579,6 +1689,8 @@ bool Tokenizer::tokenize(std::istream &code,
         return false;
     }
 
+    checkLimits();
+
     // if MACRO
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "if|for|while|BOOST_FOREACH %var% (")) {
@@ -1797,6 +1909,8 @@ bool Tokenizer::tokenize(std::istream &code,
         simplifyTypedef();
     }
 
+    checkLimits();
+
     for (Token* tok = list.front(); tok;) {
         if (Token::Match(tok, "union|struct|class union|struct|class"))
             tok->deleteNext();
@@ -1962,6 +2076,7 @@ bool Tokenizer::tokenize(std::istream &code,
 
     // Handle templates..
     simplifyTemplates();
+    checkLimits();
 
     // Simplify templates.. sometimes the "simplifyTemplates" fail and
     // then unsimplified function calls etc remain. These have the
@@ -2026,8 +2141,10 @@ bool Tokenizer::tokenize(std::istream &code,
     simplifyEmptyNamespaces();
 
     bool valid = validate();
-    if (valid)
+    if (valid) {
         createSymbolDatabase();
+        checkLimits();
+    }
     return valid;
 }
 //---------------------------------------------------------------------------
@@ -2106,6 +2223,12 @@ bool Tokenizer::tokenizeCondition(const std::string &code)
         return false;
     }
 
+    // the suffix of "0U" is removed below, remember that it is unsigned
+    for (Token *tok = list.front(); tok; tok = tok->next()) {
+        if (tok->isNumber() && MathLib::isInt(tok->str()) && tok->str().find_first_of("uU") != std::string::npos)
+            tok->isUnsigned(true);
+    }
+
     // replace 'NULL' and similar '0'-defined macros with '0'
     simplifyNull();
 
@@ -2569,8 +2692,64 @@ void Tokenizer::simplifyTemplates()
 }
 //---------------------------------------------------------------------------
 
+namespace {
+    /**
+     * @brief Variable ids of the names that are visible in the current scope.
+     * The changes made in a scope are logged and undone when the scope is
+     * left, so the map is never copied.
+     */
+    class VariableIdMap {
+    public:
+        typedef std::map<std::string, unsigned int>::const_iterator const_iterator;
+
+        const_iterator find(const std::string &name) const {
+            return _varId.find(name);
+        }
+
+        const_iterator end() const {
+            return _varId.end();
+        }
+
+        /** set the variable id for a name in the current scope */
+        void set(const std::string &name, unsigned int varid) {
+            std::map<std::string, unsigned int>::iterator it = _varId.find(name);
+            if (!_undo.empty())
+                _undo.back().push_back(std::make_pair(name, it == _varId.end() ? 0U : it->second));
+            if (it == _varId.end())
+                _varId.insert(std::make_pair(name, varid));
+            else
+                it->second = varid;
+        }
+
+        void enterScope() {
+            _undo.push_back(std::vector<std::pair<std::string, unsigned int> >());
+        }
 
-static bool setVarIdParseDeclaration(const Token **tok, const std::map<std::string,unsigned int> &variableId, bool executableScope)
+        /** restore the variable ids that were visible before the scope was entered */
+        void leaveScope() {
+            if (_undo.empty()) {
+                _varId.clear();
+                return;
+            }
+            const std::vector<std::pair<std::string, unsigned int> > &undo = _undo.back();
+            for (std::vector<std::pair<std::string, unsigned int> >::const_reverse_iterator it = undo.rbegin(); it != undo.rend(); ++it) {
+                if (it->second == 0U)
+                    _varId.erase(it->first);
+                else
+                    _varId[it->first] = it->second;
+            }
+            _undo.pop_back();
+        }
+
+    private:
+        std::map<std::string, unsigned int> _varId;
+
+        /** for each entered scope: the names that were set and their previous variable id (0 if there was none) */
+        std::vector<std::vector<std::pair<std::string, unsigned int> > > _undo;
+    };
+}
+
+static bool setVarIdParseDeclaration(const Token **tok, const VariableIdMap &variableId, bool executableScope)
 {
     const Token *tok2 = *tok;
 
@@ -2665,7 +2844,7 @@ static void setVarIdStructMembers(Token **tok1,
 
 
 static void setVarIdClassDeclaration(Token * const startToken,
-                                     const std::map<std::string, unsigned int> &variableId,
+                                     const VariableIdMap &variableId,
                                      const unsigned int scopeStartVarId,
                                      std::map<unsigned int, std::map<std::string,unsigned int> > *structMembers,
                                      unsigned int *_varId)
@@ -2694,7 +2873,7 @@ static void setVarIdClassDeclaration(Token * const startToken,
         } else if (tok->str() == "}")
             --indentlevel;
         else if (initList && indentlevel == 0 && Token::Match(tok->previous(), "[,:] %var% (")) {
-            const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
+            const VariableIdMap::const_iterator it = variableId.find(tok->str());
             if (it != variableId.end()) {
                 tok->varId(it->second);
             }
@@ -2709,7 +2888,7 @@ static void setVarIdClassDeclaration(Token * const startToken,
                         continue;
                 }
 
-                const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
+                const VariableIdMap::const_iterator it = variableId.find(tok->str());
                 if (it != variableId.end()) {
                     tok->varId(it->second);
                     setVarIdStructMembers(&tok, structMembers, _varId);
@@ -2772,9 +2951,8 @@ void Tokenizer::setVarId()
 
     // variable id
     _varId = 0;
-    std::map<std::string, unsigned int> variableId;
+    VariableIdMap variableId;
     std::map<unsigned int, std::map<std::string, unsigned int> > structMembers;
-    std::stack< std::map<std::string, unsigned int> > scopeInfo;
     std::stack<bool> executableScope;
     executableScope.push(false);
     std::stack<unsigned int> scopestartvarid;  // varid when scope starts
@@ -2785,7 +2963,7 @@ void Tokenizer::setVarId()
         // scope info to handle shadow variables..
         if (!initlist && tok->str() == "(" &&
             (Token::simpleMatch(tok->link(), ") {") || Token::Match(tok->link(), ") %type% {") || isInitList(tok->link()))) {
-            scopeInfo.push(variableId);
+            variableId.enterScope();
             initlist = Token::simpleMatch(tok->link(), ") :");
         } else if (tok->str() == "{") {
             initlist = false;
@@ -2796,7 +2974,7 @@ void Tokenizer::setVarId()
                     executableScope.push(true);
                 } else {
                     executableScope.push(executableScope.top());
-                    scopeInfo.push(variableId);
+                    variableId.enterScope();
                 }
             }
         } else if (tok->str() == "}") {
@@ -2816,12 +2994,7 @@ void Tokenizer::setVarId()
                     scopestartvarid.push(0);
                 }
 
-                if (scopeInfo.empty()) {
-                    variableId.clear();
-                } else {
-                    variableId.swap(scopeInfo.top());
-                    scopeInfo.pop();
-                }
+                variableId.leaveScope();
 
                 executableScope.pop();
                 if (executableScope.empty()) {   // should not possibly happen
@@ -2856,7 +3029,7 @@ void Tokenizer::setVarId()
             const bool decl = setVarIdParseDeclaration(&tok2, variableId, executableScope.top());
 
             if (decl && Token::Match(tok2->previous(), "%type% [;[=,)]") && tok2->previous()->str() != "const") {
-                variableId[tok2->previous()->str()] = ++_varId;
+                variableId.set(tok2->previous()->str(), ++_varId);
                 tok = tok2->previous();
             }
 
@@ -2871,7 +3044,7 @@ void Tokenizer::setVarId()
 
                 const Token *tok3 = tok2->next();
                 if (!tok3->isStandardType() && !Token::Match(tok3,"struct|union|class %type%") && !setVarIdParseDeclaration(&tok3,variableId,executableScope.top())) {
-                    variableId[tok2->previous()->str()] = ++_varId;
+                    variableId.set(tok2->previous()->str(), ++_varId);
                     tok = tok2->previous();
                 }
             }
@@ -2889,7 +3062,7 @@ void Tokenizer::setVarId()
                     continue;
             }
 
-            const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
+            const VariableIdMap::const_iterator it = variableId.find(tok->str());
             if (it != variableId.end()) {
                 tok->varId(it->second);
                 setVarIdStructMembers(&tok, &structMembers, &_varId);
@@ -3485,6 +3658,7 @@ bool Tokenizer::simplifyTokenList()
     while (modified) {
         if (_settings && _settings->terminated())
             return false;
+        checkLimits();
 
         modified = false;
         modified |= simplifyConditions();
@@ -3545,6 +3719,7 @@ bool Tokenizer::simplifyTokenList()
 
     // Create symbol database and then remove const keywords
     createSymbolDatabase();
+    checkLimits();
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::simpleMatch(tok, "* const"))
             tok->deleteNext();
@@ -6048,7 +6223,7 @@ bool Tokenizer::simplifyKnownVariables()
                 bool valueIsPointer = false;
 
                 // there could be a hang here if tok2 is moved back by the function calls below for some reason
-                if (_settings->terminated())
+                if (_settings->terminated() || _settings->timedOut())
                     return false;
 
                 if (!simplifyKnownVariablesGetData(varid, &tok2, &tok3, value, valueVarId, valueIsPointer, floatvars.find(tok2->varId()) != floatvars.end()))
@@ -6092,7 +6267,7 @@ bool Tokenizer::simplifyKnownVariables()
                 ret |= simplifyKnownVariablesSimplify(&tok2, tok3, varid, structname, value, valueVarId, valueIsPointer, valueToken, indentlevel);
 
                 // there could be a hang here if tok2 was moved back by the function call above for some reason
-                if (_settings->terminated())
+                if (_settings->terminated() || _settings->timedOut())
                     return false;
             }
         }
@@ -7019,7 +7194,7 @@ void Tokenizer::simplifyNestedStrcat()
 
 void Tokenizer::duplicateEnumError(const Token * tok1, const Token * tok2, const std::string & type) const
 {
-    if (tok1 && !(_settings->isEnabled("style")))
+    if (tok1 && !(_settings->isEnabled(Settings::Style)))
         return;
 
     std::list<const Token*> locationList;
@@ -7175,6 +7350,12 @@ public:
 
 void Tokenizer::simplifyEnum()
 {
+    if (!Token::findsimplematch(list.front(), "enum"))
+        return;
+
+    OccurrenceIndex lastOccurrence;
+    indexOccurrences(lastOccurrence, list.front());
+
     std::string className;
     int classLevel = 0;
     bool goback = false;
@@ -7365,7 +7546,17 @@ void Tokenizer::simplifyEnum()
 
                 if (!tok1)
                     return;
-                for (Token *tok2 = tok1->next(); tok2; tok2 = tok2->next()) {
+
+                // the enumerators, and a redefinition of the enum, lie at or
+                // before the last occurrence of their names
+                unsigned int lastProgress = 0;
+                bool used = enumType && occursAfter(lastOccurrence, enumType->str(), end, &lastProgress);
+                for (std::map<std::string, EnumValue>::const_iterator it = enumValues.begin(); it != enumValues.end(); ++it) {
+                    if (occursAfter(lastOccurrence, it->first, end, &lastProgress))
+                        used = true;
+                }
+
+                for (Token *tok2 = used ? tok1->next() : 0; tok2 && tok2->progressValue() <= lastProgress; tok2 = tok2->next()) {
                     if (tok2->str() == "}") {
                         --level;
                         if (level < 0)
@@ -7450,6 +7641,10 @@ void Tokenizer::simplifyEnum()
                         simplify = false;
                     }
                 }
+
+                // the enumerator values may have been copied to the uses
+                if (used)
+                    addOccurrences(lastOccurrence, start, end, lastProgress);
             }
 
             // check for a variable definition: enum {} x;
@@ -7485,7 +7680,9 @@ void Tokenizer::simplifyEnum()
                 int exitScope = 0;
                 bool simplify = false;
                 bool hasClass = false;
-                for (Token *tok2 = end->next(); tok2; tok2 = tok2->next()) {
+                unsigned int lastProgress = 0;
+                const bool used = occursAfter(lastOccurrence, enumType->str(), end, &lastProgress);
+                for (Token *tok2 = used ? end->next() : 0; tok2 && tok2->progressValue() <= lastProgress; tok2 = tok2->next()) {
                     if (tok2->str() == "}") {
                         --level;
                         if (level < 0)
@@ -7538,6 +7735,10 @@ void Tokenizer::simplifyEnum()
                         simplify = false;
                     }
                 }
+
+                // the underlying type has been copied to the uses
+                if (used && typeTokenStart)
+                    addOccurrences(lastOccurrence, typeTokenStart, typeTokenEnd, lastProgress);
             }
 
             tok1 = start;
@@ -8285,6 +8486,7 @@ void Tokenizer::getErrorMessages(ErrorLogger *errorLogger, const Settings *setti
     t.duplicateDeclarationError(0, 0, "variable");
     t.duplicateEnumError(0, 0, "variable");
     t.unnecessaryQualificationError(0, "type");
+    TemplateSimplifier::instantiationLimitError(t.list, *errorLogger, 0, "name", settings);
 }
 
 void Tokenizer::simplifyWhile0()
@@ -9205,6 +9407,43 @@ void Tokenizer::createSymbolDatabase()
             if (tok->varId())
                 tok->variable(_symbolDatabase->getVariableFromVarId(tok->varId()));
         }
+
+        const std::size_t size = _symbolDatabase->estimatedSize();
+        if (size > _peakSymbolDatabaseSize)
+            _peakSymbolDatabaseSize = size;
+    }
+}
+
+std::size_t Tokenizer::estimatedMemoryUsage() const
+{
+    return peakTokenCount() * sizeof(Token) + _peakSymbolDatabaseSize;
+}
+
+void Tokenizer::checkLimits() const
+{
+    if (_settings->timedOut()) {
+        std::ostringstream msg;
+        if (_settings->fileTimedOut())
+            msg << "Checking of this file was aborted because it took more than "
+                << _settings->_maxTime << " seconds (--max-time).";
+        else
+            msg << "Checking of this configuration was aborted because it took more than "
+                << _settings->_maxConfigTime << " seconds (--max-config-time).";
+        throw InternalError(0, msg.str(), InternalError::TIMEOUT);
+    }
+
+    if (_settings->_maxTokens > 0 && peakTokenCount() > _settings->_maxTokens) {
+        std::ostringstream msg;
+        msg << "Checking of this configuration was aborted because it needed more than "
+            << _settings->_maxTokens << " tokens (--max-tokens).";
+        throw InternalError(0, msg.str(), InternalError::LIMIT);
+    }
+
+    if (_settings->_maxMemory > 0 && estimatedMemoryUsage() / (1024 * 1024) > _settings->_maxMemory) {
+        std::ostringstream msg;
+        msg << "Checking of this configuration was aborted because it needed more than "
+            << _settings->_maxMemory << " MB of memory (--max-memory).";
+        throw InternalError(0, msg.str(), InternalError::LIMIT);
     }
 }
 
@@ -9336,7 +9575,7 @@ void Tokenizer::removeUnnecessaryQualification()
                             continue;
                     }
 
-                    if (_settings && _settings->isEnabled("portability"))
+                    if (_settings && _settings->isEnabled(Settings::Portability))
                         unnecessaryQualificationError(tok, qualification);
 
                     tok->deleteNext();
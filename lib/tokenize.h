@@ -90,6 +90,14 @@ public:
                   const char FileName[],
                   const std::string &configuration = "");
 
+    /**
+     * Tokenize code that is already in memory, such as the output of the
+     * preprocessor. See tokenize(std::istream &, const char [], const std::string &).
+     */
+    bool tokenize(const std::string &code,
+                  const char FileName[],
+                  const std::string &configuration = "");
+
     /**
      * tokenize condition and run simple simplifications on it
      * @param code code
@@ -689,6 +697,34 @@ public:
     void createSymbolDatabase();
     void deleteSymbolDatabase();
 
+    /** @brief Number of tokens that the token list and its copies have created */
+    std::size_t allocatedTokenCount() const {
+        return list.allocatedTokenCount();
+    }
+
+    /** @brief Highest number of tokens in the token list and its copies at once */
+    std::size_t peakTokenCount() const {
+        return list.peakTokenCount();
+    }
+
+    /** @brief Highest estimated size of the symbol database, in bytes */
+    std::size_t peakSymbolDatabaseSize() const {
+        return _peakSymbolDatabaseSize;
+    }
+
+    /** @brief Estimated peak memory used by the tokens and the symbol database, in bytes */
+    std::size_t estimatedMemoryUsage() const;
+
+    /**
+     * @brief Abort the checking of the configuration if it has run out of
+     * time or exceeds the --max-tokens or --max-memory limit. The peak is
+     * checked, so the limit is noticed even if the tokens were freed again
+     * before this call. Only call it where an exception leaves no unowned
+     * tokens behind.
+     * @throw InternalError of type TIMEOUT or LIMIT
+     */
+    void checkLimits() const;
+
     Token *deleteInvalidTypedef(Token *typeDef);
 
     /**
@@ -766,6 +802,9 @@ private:
      * TimerResults
      */
     TimerResults *m_timerResults;
+
+    /** Highest estimated size of the symbol database, in bytes */
+    std::size_t _peakSymbolDatabaseSize;
 };
 
 /// @}
@@ -28,12 +28,13 @@
 #include <cstring>
 #include <sstream>
 #include <cctype>
+#include <map>
 #include <stack>
+#include <vector>
 
 
 TokenList::TokenList(const Settings* settings) :
     _front(0),
-    _back(0),
     _settings(settings)
 {
 }
@@ -50,7 +51,7 @@ void TokenList::deallocateTokens()
 {
     deleteTokens(_front);
     _front = 0;
-    _back = 0;
+    _tokensBack.back = 0;
     _files.clear();
 }
 
@@ -89,25 +90,29 @@ void TokenList::addtoken(const char str[], const unsigned int lineno, const unsi
     }
 
     // Replace hexadecimal value with decimal
-    std::ostringstream str2;
-    if (MathLib::isHex(str) || MathLib::isOct(str) || MathLib::isBin(str)) {
-        str2 << MathLib::toLongNumber(str);
+    std::string str2;
+    if (std::isdigit(static_cast<unsigned char>(str[0])) &&
+        (MathLib::isHex(str) || MathLib::isOct(str) || MathLib::isBin(str))) {
+        str2 = MathLib::longToString(MathLib::toLongNumber(str));
+        // keep the unsigned suffix
+        if (std::strpbrk(str, "uU"))
+            str2 += 'U';
     } else if (std::strncmp(str, "_Bool", 5) == 0) {
-        str2 << "bool";
+        str2 = "bool";
     } else {
-        str2 << str;
+        str2 = str;
     }
 
-    if (_back) {
-        _back->insertToken(str2.str());
+    if (_tokensBack.back) {
+        _tokensBack.back->insertToken(str2);
     } else {
-        _front = new Token(&_back);
-        _back = _front;
-        _back->str(str2.str());
+        _front = new Token(&_tokensBack);
+        _tokensBack.back = _front;
+        _tokensBack.back->str(str2);
     }
 
-    _back->linenr(lineno);
-    _back->fileIndex(fileno);
+    _tokensBack.back->linenr(lineno);
+    _tokensBack.back->fileIndex(fileno);
 }
 
 void TokenList::addtoken(const Token * tok, const unsigned int lineno, const unsigned int fileno)
@@ -115,20 +120,20 @@ void TokenList::addtoken(const Token * tok, const unsigned int lineno, const uns
     if (tok == 0)
         return;
 
-    if (_back) {
-        _back->insertToken(tok->str());
+    if (_tokensBack.back) {
+        _tokensBack.back->insertToken(tok->str());
     } else {
-        _front = new Token(&_back);
-        _back = _front;
-        _back->str(tok->str());
+        _front = new Token(&_tokensBack);
+        _tokensBack.back = _front;
+        _tokensBack.back->str(tok->str());
     }
 
-    _back->linenr(lineno);
-    _back->fileIndex(fileno);
-    _back->isUnsigned(tok->isUnsigned());
-    _back->isSigned(tok->isSigned());
-    _back->isLong(tok->isLong());
-    _back->isUnused(tok->isUnused());
+    _tokensBack.back->linenr(lineno);
+    _tokensBack.back->fileIndex(fileno);
+    _tokensBack.back->isUnsigned(tok->isUnsigned());
+    _tokensBack.back->isSigned(tok->isSigned());
+    _tokensBack.back->isLong(tok->isLong());
+    _tokensBack.back->isUnused(tok->isUnused());
 }
 //---------------------------------------------------------------------------
 // InsertTokens - Copy and insert tokens
@@ -169,9 +174,23 @@ void TokenList::insertTokens(Token *dest, const Token *src, unsigned int n)
 //---------------------------------------------------------------------------
 
 bool TokenList::createTokens(std::istream &code, const std::string& file0)
+{
+    // Read all the code at once and tokenize it from memory
+    std::ostringstream ostr;
+    ostr << code.rdbuf();
+    return createTokens(ostr.str(), file0);
+}
+
+bool TokenList::createTokens(const std::string &code, const std::string& file0)
 {
     _files.push_back(file0);
 
+    // Characters that separate tokens. The terminating '\0' is included.
+    static const char separators[] = "+-*/%&|^?!=<>[](){};:,.~\n ";
+    bool isSeparator[256] = { false };
+    for (unsigned int i = 0; i < sizeof(separators); ++i)
+        isSeparator[static_cast<unsigned char>(separators[i])] = true;
+
     // line number in parsed code
     unsigned int lineno = 1;
 
@@ -193,11 +212,14 @@ bool TokenList::createTokens(std::istream &code, const std::string& file0)
 
     bool expandedMacro = false;
 
+    const std::string::size_type size = code.size();
+
     // Read one byte at a time from code and create tokens
-    for (char ch = (char)code.get(); code.good(); ch = (char)code.get()) {
+    for (std::string::size_type pos = 0; pos < size; ++pos) {
+        char ch = code[pos];
         if (ch == Preprocessor::macroChar) {
-            while (code.peek() == Preprocessor::macroChar)
-                code.get();
+            while (pos + 1 < size && code[pos + 1] == Preprocessor::macroChar)
+                ++pos;
             ch = ' ';
             expandedMacro = true;
         } else if (ch == '\n') {
@@ -207,24 +229,15 @@ bool TokenList::createTokens(std::istream &code, const std::string& file0)
         // char/string..
         // multiline strings are not handled. The preprocessor should handle that for us.
         else if (ch == '\'' || ch == '\"') {
-            std::string line;
-
-            // read char
+            // find the end of the char/string
+            const std::string::size_type start = pos;
             bool special = false;
-            char c = ch;
-            do {
-                // Append token..
-                line += c;
-
+            for (++pos; pos < size && (special || code[pos] != ch); ++pos) {
                 // Special sequence '\.'
-                if (special)
-                    special = false;
-                else
-                    special = (c == '\\');
+                special = !special && code[pos] == '\\';
+            }
 
-                // Get next character
-                c = (char)code.get();
-            } while (code.good() && (special || c != ch));
+            std::string line(code, start, pos - start);
             line += ch;
 
             // Handle #file "file.h"
@@ -256,12 +269,12 @@ bool TokenList::createTokens(std::istream &code, const std::string& file0)
                 // Add previous token
                 addtoken(CurrentToken.c_str(), lineno, FileIndex);
                 if (!CurrentToken.empty())
-                    _back->setExpandedMacro(expandedMacro);
+                    _tokensBack.back->setExpandedMacro(expandedMacro);
 
                 // Add content of the string
                 addtoken(line.c_str(), lineno, FileIndex);
                 if (!line.empty())
-                    _back->setExpandedMacro(expandedMacro);
+                    _tokensBack.back->setExpandedMacro(expandedMacro);
             }
 
             CurrentToken.clear();
@@ -273,25 +286,27 @@ bool TokenList::createTokens(std::istream &code, const std::string& file0)
             CurrentToken.length() > 0 &&
             std::isdigit(CurrentToken[0])) {
             // Don't separate doubles "5.4"
-        } else if (std::strchr("+-", ch) &&
+        } else if ((ch == '+' || ch == '-') &&
                    CurrentToken.length() > 0 &&
                    std::isdigit(CurrentToken[0]) &&
                    (CurrentToken[CurrentToken.length()-1] == 'e' ||
                     CurrentToken[CurrentToken.length()-1] == 'E') &&
                    !MathLib::isHex(CurrentToken)) {
             // Don't separate doubles "4.2e+10"
-        } else if (CurrentToken.empty() && ch == '.' && std::isdigit(code.peek())) {
+        } else if (CurrentToken.empty() && ch == '.' && pos + 1 < size && std::isdigit(static_cast<unsigned char>(code[pos + 1]))) {
             // tokenize .125 into 0.125
             CurrentToken = "0";
-        } else if (std::strchr("+-*/%&|^?!=<>[](){};:,.~\n ", ch)) {
+        } else if (isSeparator[static_cast<unsigned char>(ch)]) {
             if (CurrentToken == "#file") {
                 // Handle this where strings are handled
                 continue;
             } else if (CurrentToken == "#line") {
                 // Read to end of line
-                std::string line;
-
-                std::getline(code, line);
+                std::string::size_type endOfLine = code.find('\n', pos + 1);
+                if (endOfLine == std::string::npos)
+                    endOfLine = size;
+                const std::string line(code, pos + 1, endOfLine - pos - 1);
+                pos = endOfLine;
 
                 // Update the current line number
                 unsigned int row;
@@ -317,7 +332,7 @@ bool TokenList::createTokens(std::istream &code, const std::string& file0)
 
             addtoken(CurrentToken.c_str(), lineno, FileIndex, true);
             if (!CurrentToken.empty())
-                _back->setExpandedMacro(expandedMacro);
+                _tokensBack.back->setExpandedMacro(expandedMacro);
 
             CurrentToken.clear();
 
@@ -330,10 +345,10 @@ bool TokenList::createTokens(std::istream &code, const std::string& file0)
 
             CurrentToken += ch;
             // Add "++", "--", ">>" or ... token
-            if (std::strchr("+-<>=:&|", ch) && (code.peek() == ch))
-                CurrentToken += (char)code.get();
+            if (std::strchr("+-<>=:&|", ch) && pos + 1 < size && code[pos + 1] == ch)
+                CurrentToken += code[++pos];
             addtoken(CurrentToken.c_str(), lineno, FileIndex);
-            _back->setExpandedMacro(expandedMacro);
+            _tokensBack.back->setExpandedMacro(expandedMacro);
             CurrentToken.clear();
             continue;
         }
@@ -342,11 +357,14 @@ bool TokenList::createTokens(std::istream &code, const std::string& file0)
     }
     addtoken(CurrentToken.c_str(), lineno, FileIndex, true);
     if (!CurrentToken.empty())
-        _back->setExpandedMacro(expandedMacro);
-    _front->assignProgressValues();
+        _tokensBack.back->setExpandedMacro(expandedMacro);
+    if (_front)
+        _front->assignProgressValues();
 
-    for (unsigned int i = 1; i < _files.size(); i++)
-        _files[i] = Path::getRelativePath(_files[i], _settings->_basePaths);
+    if (_settings) {
+        for (unsigned int i = 1; i < _files.size(); i++)
+            _files[i] = Path::getRelativePath(_files[i], _settings->_basePaths);
+    }
 
     return true;
 }
@@ -372,27 +390,51 @@ void TokenList::createAst()
         " || ",
         " = ? : ",
         " throw ",
-        " , "
-        " [ "
+        " , [ "
     };
+    const unsigned int levels = sizeof(operators) / sizeof(*operators);
+
+    // For each operator, the precedence levels it belongs to (bitmask)
+    std::map<std::string, unsigned int> operatorLevels;
+    for (unsigned int i = 0; i < levels; ++i) {
+        std::istringstream istr(operators[i] + (*operators[i] == '>' ? 1 : 0));
+        std::string op;
+        while (istr >> op)
+            operatorLevels[op] |= 1U << i;
+    }
+
+    // Collect the tokens for each precedence level in one walk, the
+    // passes below then only visit the tokens they handle.
+    std::vector<std::vector<Token *> > operatorTokens(levels);
+    std::vector<Token *> functionCalls;
+    std::vector<Token *> parentheses;
+    for (Token *tok = _front; tok; tok = tok->next()) {
+        const std::map<std::string, unsigned int>::const_iterator it = operatorLevels.find(tok->str());
+        if (it != operatorLevels.end()) {
+            for (unsigned int i = 0; i < levels; ++i) {
+                if (it->second & (1U << i))
+                    operatorTokens[i].push_back(tok);
+            }
+        }
 
-    for (unsigned int i = 0; i < sizeof(operators) / sizeof(*operators); ++i) {
-        // TODO: extract operators to std::set - that should be faster
+        if (Token::Match(tok, "%var% ("))
+            functionCalls.push_back(tok);
+        else if (Token::Match(tok, "(|)|]"))
+            parentheses.push_back(tok);
+    }
+
+    for (unsigned int i = 0; i < levels; ++i) {
+        const std::vector<Token *> &tokens = operatorTokens[i];
         if (*operators[i] == '>') {  // Unary operators, parse from right to left
-            const std::string op(1+operators[i]);
-            Token *tok = _front;
-            while (tok->next())
-                tok = tok->next();
-            for (; tok; tok = tok->previous()) {
-                if ((!tok->previous() || tok->previous()->isOp()) &&
-                    op.find(" "+tok->str()+" ")!=std::string::npos) {
+            for (std::vector<Token *>::const_reverse_iterator it = tokens.rbegin(); it != tokens.rend(); ++it) {
+                Token * const tok = *it;
+                if (!tok->previous() || tok->previous()->isOp())
                     tok->astOperand1(tok->next());
-                }
             }
         } else {  // parse from left to right
-            const std::string op(operators[i]);
-            for (Token *tok = _front; tok; tok = tok->next()) {
-                if (tok->astOperand1()==NULL && op.find(" "+tok->str()+" ")!=std::string::npos) {
+            for (std::vector<Token *>::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+                Token * const tok = *it;
+                if (tok->astOperand1()==NULL) {
                     if (tok->type() != Token::eIncDecOp) {
                         tok->astOperand1(tok->previous());
                         tok->astOperand2(tok->next());
@@ -405,17 +447,12 @@ void TokenList::createAst()
     }
 
     // function calls..
-    for (Token *tok = _front; tok; tok = tok->next()) {
-        if (Token::Match(tok, "%var% ("))
-            tok->astFunctionCall();
-    }
+    for (std::vector<Token *>::const_iterator it = functionCalls.begin(); it != functionCalls.end(); ++it)
+        (*it)->astFunctionCall();
 
     // parentheses..
-    for (Token *tok = _front; tok; tok = tok->next()) {
-        if (Token::Match(tok, "(|)|]")) {
-            tok->astHandleParentheses();
-        }
-    }
+    for (std::vector<Token *>::const_iterator it = parentheses.begin(); it != parentheses.end(); ++it)
+        (*it)->astHandleParentheses();
 }
 
 const std::string& TokenList::file(const Token *tok) const
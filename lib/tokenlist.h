@@ -25,8 +25,8 @@
 #include <string>
 #include <vector>
 #include "config.h"
+#include "token.h"
 
-class Token;
 class Settings;
 
 /// @addtogroup Core
@@ -63,6 +63,14 @@ public:
      */
     bool createTokens(std::istream &code, const std::string& file0 = "");
 
+    /**
+     * Create tokens from code that is already in memory.
+     * See createTokens(std::istream &, const std::string &).
+     * @param code the preprocessed code
+     * @param file0 source file name
+     */
+    bool createTokens(const std::string &code, const std::string& file0 = "");
+
     /** Deallocate list */
     void deallocateTokens();
 
@@ -76,10 +84,28 @@ public:
 
     /** get last token of list */
     const Token *back() const {
-        return _back;
+        return _tokensBack.back;
     }
     Token *back() {
-        return _back;
+        return _tokensBack.back;
+    }
+
+    /** @brief Number of tokens that this list and its copies have created */
+    std::size_t allocatedTokenCount() const {
+        return _tokensBack.allocated;
+    }
+
+    /** @brief Highest number of tokens in this list and its copies at once */
+    std::size_t peakTokenCount() const {
+        return _tokensBack.peakLive;
+    }
+
+    /**
+     * @brief The counters of this list. Checks that copy the tokens into
+     * their own list use it as TokensBack::parent of that list.
+     */
+    TokensBack *tokensBack() const {
+        return &_tokensBack;
     }
 
     /**
@@ -118,7 +144,11 @@ public:
 
 private: /// private
     /** Token list */
-    Token *_front, *_back;
+    Token *_front;
+
+    /** last token and token counters, shared by the tokens. Copies of a
+        const list are counted too, so it is mutable. */
+    mutable TokensBack _tokensBack;
 
     /** filenames for the tokenized source code (source + included) */
     std::vector<std::string> _files;
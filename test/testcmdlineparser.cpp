@@ -85,6 +85,12 @@ private:
         TEST_CASE(maxConfigsMissingCount);
         TEST_CASE(maxConfigsInvalid);
         TEST_CASE(maxConfigsTooSmall);
+        TEST_CASE(maxTemplateInstantiations);
+        TEST_CASE(maxTemplateTokensInvalid);
+        TEST_CASE(maxTokens);
+        TEST_CASE(maxMemoryInvalid);
+        TEST_CASE(maxTime);
+        TEST_CASE(maxConfigTimeInvalid);
         TEST_CASE(reportProgressTest); // "Test" suffix to avoid hiding the parent's reportProgress
         TEST_CASE(stdposix);
         TEST_CASE(stdc99);
@@ -493,6 +499,9 @@ private:
         ASSERT(settings.isEnabled("unusedFunction"));
         ASSERT(settings.isEnabled("missingInclude"));
         ASSERT(!settings.isEnabled("internal"));
+        ASSERT(settings.isEnabled(Settings::Style));
+        ASSERT(settings.isEnabled(Settings::UnusedFunction));
+        ASSERT(!settings.isEnabled(Settings::Internal));
     }
 
     void enabledStyle() {
@@ -708,6 +717,63 @@ private:
         ASSERT_EQUALS(false, parser.ParseFromArgs(3, argv));
     }
 
+    void maxTemplateInstantiations() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-template-instantiations=50", "--max-template-tokens=2000", "file.cpp"};
+        Settings settings;
+        CmdLineParser parser(&settings);
+        ASSERT(parser.ParseFromArgs(4, argv));
+        ASSERT_EQUALS(50, settings._maxTemplateInstantiations);
+        ASSERT_EQUALS(2000, settings._maxTemplateTokens);
+    }
+
+    void maxTemplateTokensInvalid() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-template-tokens=e", "file.cpp"};
+        Settings settings;
+        CmdLineParser parser(&settings);
+        // Fails since invalid count given for --max-template-tokens=
+        ASSERT_EQUALS(false, parser.ParseFromArgs(3, argv));
+    }
+
+    void maxTokens() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-tokens=100000", "--max-memory=512", "file.cpp"};
+        Settings settings;
+        CmdLineParser parser(&settings);
+        ASSERT(parser.ParseFromArgs(4, argv));
+        ASSERT_EQUALS(100000, settings._maxTokens);
+        ASSERT_EQUALS(512, settings._maxMemory);
+    }
+
+    void maxMemoryInvalid() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-memory=e", "file.cpp"};
+        Settings settings;
+        CmdLineParser parser(&settings);
+        // Fails since invalid size given for --max-memory=
+        ASSERT_EQUALS(false, parser.ParseFromArgs(3, argv));
+    }
+
+    void maxTime() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-time=60", "--max-config-time=10", "file.cpp"};
+        Settings settings;
+        CmdLineParser parser(&settings);
+        ASSERT(parser.ParseFromArgs(4, argv));
+        ASSERT_EQUALS(60, settings._maxTime);
+        ASSERT_EQUALS(10, settings._maxConfigTime);
+    }
+
+    void maxConfigTimeInvalid() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-config-time=e", "file.cpp"};
+        Settings settings;
+        CmdLineParser parser(&settings);
+        // Fails since invalid time given for --max-config-time=
+        ASSERT_EQUALS(false, parser.ParseFromArgs(3, argv));
+    }
+
     void reportProgressTest() {
         REDIRECT;
         const char *argv[] = {"cppcheck", "--report-progress", "file.cpp"};
@@ -25,9 +25,13 @@
 #include "cppcheckexecutor.h"
 #include "testsuite.h"
 #include "path.h"
+#include "tokenize.h"
 
 #include <algorithm>
 #include <list>
+#include <map>
+#include <set>
+#include <sstream>
 #include <string>
 
 extern std::ostringstream errout;
@@ -52,10 +56,27 @@ private:
         }
     };
 
+    /** @brief Collects the severities that are reported */
+    class SeverityLogger : public ErrorLogger {
+    public:
+        std::set<Severity::SeverityType> severities;
+
+        void reportOut(const std::string & /*outmsg*/) {
+        }
+
+        void reportErr(const ErrorLogger::ErrorMessage &msg) {
+            severities.insert(msg._severity);
+        }
+    };
+
     void run() {
         TEST_CASE(instancesSorted);
         TEST_CASE(classInfoFormat);
         TEST_CASE(getErrorMessages);
+        TEST_CASE(reportedSeveritiesListed);
+        TEST_CASE(maxTokens);
+        TEST_CASE(maxConfigTime);
+        TEST_CASE(maxTime);
     }
 
     void instancesSorted() {
@@ -98,6 +119,155 @@ private:
         }
         ASSERT_EQUALS("", duplicate);
     }
+
+    // CppCheck skips checkers whose listed severities are all disabled,
+    // so every severity a checker reports must be listed by getErrorMessages()
+    void reportedSeveritiesListed() {
+        const char code[] = "#include <cstdio>\n"
+                            "#include <cstring>\n"
+                            "#include <string>\n"
+                            "#include <vector>\n"
+                            "class Fred {\n"
+                            "public:\n"
+                            "    Fred() { }\n"
+                            "    Fred(const Fred &) { }\n"
+                            "    ~Fred() { throw 1; }\n"
+                            "    int get() { return x; }\n"
+                            "    void operator=(const Fred &f) { x = f.x; }\n"
+                            "    char *p;\n"
+                            "private:\n"
+                            "    void unused() { }\n"
+                            "    int x;\n"
+                            "};\n"
+                            "struct Base { virtual void f() = 0; };\n"
+                            "struct Derived : public Base { Derived() { p = new char[10]; } char *p; void f() { } };\n"
+                            "int *g() { int a = 0; return &a; }\n"
+                            "int p64(int *p) { return p; }\n"
+                            "void fb(std::vector<int> &v) { BOOST_FOREACH(int i, v) { v.push_back(i); } }\n"
+                            "int fu() { int u; u++; return u; }\n"
+                            "void fl() { char *r = malloc(10); }\n"
+                            "void h(std::vector<int> &v, const std::string &s, char *str) {\n"
+                            "    char buf[10];\n"
+                            "    int i, j = 0, k;\n"
+                            "    char *q = malloc(10);\n"
+                            "    FILE *fp = fopen(\"a\", \"r\");\n"
+                            "    std::vector<int>::iterator it;\n"
+                            "    buf[10] = 0;\n"
+                            "    strcpy(buf, \"abcdefghijklmnop\");\n"
+                            "    sprintf(buf, \"%s\", buf);\n"
+                            "    printf(\"%d\", s);\n"
+                            "    gets(buf);\n"
+                            "    str = strtok(str, \",\");\n"
+                            "    for (it = v.begin(); it != v.end(); it++)\n"
+                            "        v.push_back(*it);\n"
+                            "    if (s.find(\"x\") == 0 || v.size() == 0) { }\n"
+                            "    if (j == 0 && j == 1) { }\n"
+                            "    if ((j & 4) == 3) { }\n"
+                            "    j = j;\n"
+                            "    k = i;\n"
+                            "    j == 1;\n"
+                            "    bool b = true; b++;\n"
+                            "    long l = (long)&j;\n"
+                            "    q[0] = (char)l;\n"
+                            "    char c = str[0]; buf[c] = 0;\n"
+                            "    j = 1 / 0;\n"
+                            "    int *n = 0; *n = 0;\n"
+                            "    std::auto_ptr<int> ap(new int[2]);\n"
+                            "    try { } catch (std::exception e) { }\n"
+                            "    switch (j) { case 1: k = 1; case 2: k = 2; break; }\n"
+                            "    memset(buf, 0, 100);\n"
+                            "    alloca(10);\n"
+                            "    usleep(1);\n"
+                            "}\n";
+
+        Settings settings;
+        settings.addEnabled("all");
+        settings.inconclusive = true;
+        settings.experimental = true;
+
+        ErrorLogger2 errorLogger;
+        Tokenizer tokenizer(&settings, &errorLogger);
+        std::istringstream istr(code);
+        ASSERT(tokenizer.tokenize(istr, "test.cpp"));
+
+        std::map<const Check *, SeverityLogger> reported;
+        for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it)
+            (*it)->runChecks(&tokenizer, &settings, &reported[*it]);
+        tokenizer.simplifyTokenList();
+        for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it)
+            (*it)->runSimplifiedChecks(&tokenizer, &settings, &reported[*it]);
+
+        std::string unlisted;
+        for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
+            if ((*it)->hasUnlistedMessages())
+                continue;
+            SeverityLogger listed;
+            (*it)->getErrorMessages(&listed, &settings);
+            const std::set<Severity::SeverityType> &severities = reported[*it].severities;
+            for (std::set<Severity::SeverityType>::const_iterator sev = severities.begin(); sev != severities.end(); ++sev) {
+                if (listed.severities.find(*sev) == listed.severities.end())
+                    unlisted += (*it)->name() + ": " + Severity::toString(*sev) + "\n";
+            }
+        }
+        ASSERT_EQUALS("", unlisted);
+    }
+
+    void maxTokens() {
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings()._maxTokens = 10;
+        cppCheck.check("test.cpp", "void f() { int a; int b; int c; int d; }");
+        ASSERT_EQUALS(1U, errorLogger.id.size());
+        ASSERT_EQUALS("resourceLimit", errorLogger.id.front());
+
+        errorLogger.id.clear();
+        cppCheck.settings()._maxTokens = 100;
+        cppCheck.check("test.cpp", "void f() { int a; int b; int c; int d; }");
+        ASSERT_EQUALS(0U, errorLogger.id.size());
+    }
+
+    void maxConfigTime() {
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings()._maxConfigTime = 1;
+        cppCheck.settings()._timerStartElapsed = 10;
+        cppCheck.check("test.cpp", "#ifdef A\n"
+                       "void f() { char a[10]; a[10] = 0; }\n"
+                       "#else\n"
+                       "void g() { char b[10]; b[10] = 0; }\n"
+                       "#endif\n");
+        // each configuration runs out of time, the file is still checked
+        ASSERT_EQUALS(2U, errorLogger.id.size());
+        ASSERT_EQUALS("timeout", errorLogger.id.front());
+        ASSERT_EQUALS("timeout", errorLogger.id.back());
+    }
+
+    void maxTime() {
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings()._maxTime = 1;
+        cppCheck.settings()._timerStartElapsed = 10;
+        cppCheck.check("test.cpp", "#ifdef A\n"
+                       "void f() { char a[10]; a[10] = 0; }\n"
+                       "#else\n"
+                       "void g() { char b[10]; b[10] = 0; }\n"
+                       "#endif\n");
+        // the remaining configuration is skipped
+        ASSERT_EQUALS(1U, errorLogger.id.size());
+        ASSERT_EQUALS("timeout", errorLogger.id.front());
+
+        // no errors are missed when there is time
+        errorLogger.id.clear();
+        cppCheck.settings()._timerStartElapsed = 0;
+        cppCheck.settings()._maxTime = 100;
+        cppCheck.check("test.cpp", "#ifdef A\n"
+                       "void f() { char a[10]; a[10] = 0; }\n"
+                       "#else\n"
+                       "void g() { char b[10]; b[10] = 0; }\n"
+                       "#endif\n");
+        ASSERT_EQUALS(2U, errorLogger.id.size());
+        ASSERT_EQUALS("arrayIndexOutOfBounds", errorLogger.id.front());
+    }
 };
 
 REGISTER_TEST(TestCppcheck)
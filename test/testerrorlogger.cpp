@@ -20,6 +20,8 @@
 #include "cppcheck.h"
 #include "testsuite.h"
 #include "errorlogger.h"
+#include "tokenlist.h"
+#include "token.h"
 
 class TestErrorLogger : public TestFixture {
 public:
@@ -44,6 +46,7 @@ private:
         TEST_CASE(ToVerboseXmlLocations);
         TEST_CASE(ToXmlV2);
         TEST_CASE(ToXmlV2Locations);
+        TEST_CASE(TokenMessageConvert);
 
         // Inconclusive results in xml reports..
         TEST_CASE(InconclusiveXml);
@@ -54,6 +57,33 @@ private:
         TEST_CASE(suppressUnmatchedSuppressions);
     }
 
+    void TokenMessageConvert() {
+        TokenList list(0);
+        list.createTokens(std::string("a ; b ; c ;"), "foo.cpp");
+        const Token *a = list.front();
+        const Token *b = a->tokAt(2);
+        const Token *c = b->tokAt(2);
+        std::list<const Token *> callstack;
+        callstack.push_back(a);
+        callstack.push_back(0);
+        callstack.push_back(b);
+        callstack.push_back(c);
+
+        const std::string id("errorId");
+        const std::string text("Programming error.\nVerbose error");
+        const ErrorLogger::TokenMessage msg(callstack, &list, Severity::error, id, text, true);
+        ASSERT_EQUALS(3U, msg.size());
+        ASSERT_EQUALS("foo.cpp", msg.file(msg.location(2)));
+
+        const ErrorMessage converted(msg.toErrorMessage());
+        ASSERT_EQUALS(3, (int)converted._callStack.size());
+        ASSERT_EQUALS("foo.cpp", converted.file0);
+        ASSERT_EQUALS("Programming error.", converted.shortMessage());
+        ASSERT_EQUALS("Verbose error", converted.verboseMessage());
+        ASSERT_EQUALS(true, converted._inconclusive);
+        ASSERT_EQUALS("[foo.cpp:1] -> [foo.cpp:1] -> [foo.cpp:1]: (error, inconclusive) Programming error.", converted.toString(false));
+    }
+
     void FileLocationDefaults() {
         ErrorLogger::ErrorMessage::FileLocation loc;
         ASSERT_EQUALS("", loc.getfile());
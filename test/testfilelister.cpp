@@ -26,6 +26,8 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <errno.h>
+#include <cstdio>
+#include <sys/stat.h>
 #endif
 
 class TestFileLister: public TestFixture {
@@ -35,6 +37,51 @@ public:
     {}
 
 private:
+#ifndef _WIN32
+    /** @brief Temporary directory tree that is removed by the destructor */
+    class TempDir {
+    public:
+        TempDir() {
+            char name[] = "/tmp/cppcheck-filelister-XXXXXX";
+            if (mkdtemp(name))
+                path = std::string(name) + '/';
+        }
+
+        ~TempDir() {
+            for (std::vector<std::string>::reverse_iterator it = entries.rbegin(); it != entries.rend(); ++it)
+                std::remove((path + *it).c_str());
+            if (!path.empty())
+                rmdir(path.c_str());
+        }
+
+        void dir(const std::string &name) {
+            mkdir((path + name).c_str(), 0700);
+            entries.push_back(name);
+        }
+
+        void file(const std::string &name, const std::string &content) {
+            std::ofstream fout((path + name).c_str());
+            fout << content;
+            entries.push_back(name);
+        }
+
+        void symlink(const std::string &name, const std::string &target) {
+            if (::symlink(target.c_str(), (path + name).c_str()) == 0)
+                entries.push_back(name);
+        }
+
+        void hardlink(const std::string &name, const std::string &existing) {
+            if (::link((path + existing).c_str(), (path + name).c_str()) == 0)
+                entries.push_back(name);
+        }
+
+        std::string path;
+
+    private:
+        std::vector<std::string> entries;
+    };
+#endif
+
     void run() {
         // bail out if the tests are not executed from the base folder
         {
@@ -48,6 +95,12 @@ private:
         TEST_CASE(absolutePath);
 #endif
         TEST_CASE(recursiveAddFiles);
+#ifndef _WIN32
+        TEST_CASE(symlinkLoop);
+        TEST_CASE(hardlinkedFiles);
+        TEST_CASE(symlinkedFile);
+        TEST_CASE(unknownEntryType);
+#endif
     }
 
     void isDirectory() const {
@@ -95,6 +148,67 @@ private:
         // Make sure headers are not added..
         ASSERT(files.find("lib/tokenize.h") == files.end());
     }
+
+#ifndef _WIN32
+    void symlinkLoop() const {
+        TempDir tmp;
+        tmp.file("a.cpp", "int a;");
+        tmp.dir("sub");
+        tmp.file("sub/b.cpp", "int b;");
+        tmp.symlink("sub/loop", "..");
+
+        // The walk ends and every file is added once
+        std::map<std::string, std::size_t> files;
+        FileLister::recursiveAddFiles(files, tmp.path);
+        ASSERT_EQUALS(2U, files.size());
+        ASSERT(files.find(tmp.path + "a.cpp") != files.end());
+        ASSERT(files.find(tmp.path + "sub/b.cpp") != files.end());
+    }
+
+    void hardlinkedFiles() const {
+        TempDir tmp;
+        tmp.dir("sub");
+        tmp.file("sub/a.cpp", "int a;");
+        tmp.hardlink("sub/b.cpp", "sub/a.cpp");
+
+        // Hard links are different files, like with realpath()
+        std::map<std::string, std::size_t> files;
+        FileLister::recursiveAddFiles(files, tmp.path);
+        ASSERT_EQUALS(2U, files.size());
+    }
+
+    void symlinkedFile() const {
+        TempDir tmp;
+        tmp.dir("sub");
+        tmp.file("sub/a.cpp", "int a;");
+        tmp.symlink("sub/b.cpp", "a.cpp");
+
+        // A link to a file that is already listed is skipped
+        std::map<std::string, std::size_t> files;
+        FileLister::recursiveAddFiles(files, tmp.path);
+        ASSERT_EQUALS(1U, files.size());
+    }
+
+    void unknownEntryType() const {
+        // Some file systems report every entry as DT_UNKNOWN (0)
+        TempDir tmp;
+        tmp.dir("sub");
+        tmp.file("a.cpp", "int a;");
+        tmp.file("a.h", "int a;");
+
+        std::set<std::string> seen;
+        std::map<std::string, std::size_t> files;
+        std::set<std::string> subdirs;
+        FileLister::addEntry(seen, files, subdirs, tmp.path + "sub", tmp.path + "sub", 0);
+        FileLister::addEntry(seen, files, subdirs, tmp.path + "a.cpp", tmp.path + "a.cpp", 0);
+        FileLister::addEntry(seen, files, subdirs, tmp.path + "a.h", tmp.path + "a.h", 0);
+
+        ASSERT_EQUALS(1U, subdirs.size());
+        ASSERT_EQUALS(tmp.path + "sub/", *subdirs.begin());
+        ASSERT_EQUALS(1U, files.size());
+        ASSERT_EQUALS(6U, files[tmp.path + "a.cpp"]);
+    }
+#endif
 };
 
 REGISTER_TEST(TestFileLister)
@@ -188,6 +188,17 @@ private:
         // from long long
         ASSERT_EQUALS(0xFF00000000000000LL, MathLib::toLongNumber("0xFF00000000000000LL"));
         ASSERT_EQUALS(0x0A00000000000000LL, MathLib::toLongNumber("0x0A00000000000000LL"));
+        ASSERT_EQUALS(-1, MathLib::toLongNumber("0xFFFFFFFFFFFFFFFF"));
+        ASSERT_EQUALS(9223372036854775807LL, MathLib::toLongNumber("9223372036854775807"));
+        ASSERT_EQUALS(9223372036854775807LL, MathLib::toLongNumber("99999999999999999999"));
+        ASSERT_EQUALS(-9223372036854775807LL - 1, MathLib::toLongNumber("-9223372036854775808"));
+        ASSERT_EQUALS(123, MathLib::toLongNumber("123UL"));
+
+        // to string
+        ASSERT_EQUALS("0", MathLib::longToString(0));
+        ASSERT_EQUALS("-42", MathLib::longToString(-42));
+        ASSERT_EQUALS("9223372036854775807", MathLib::longToString(9223372036854775807LL));
+        ASSERT_EQUALS("-9223372036854775808", MathLib::longToString(-9223372036854775807LL - 1));
 
         // -----------------
         // to double number:
@@ -358,6 +358,9 @@ private:
         TEST_CASE(garbageCode);
 
         TEST_CASE(ptrptr);
+
+        // the code copied by getcode counts towards --max-tokens
+        TEST_CASE(maxTokens);
     }
 
 
@@ -3864,6 +3867,26 @@ private:
         ASSERT_EQUALS("[test.cpp:5]: (error) Memory leak: p\n", errout.str());
     }
 
+    void maxTokens() {
+        errout.str("");
+
+        Settings settings;
+        Tokenizer tokenizer(&settings, this);
+        std::istringstream istr("void f() {\n"
+                                "    char *p = malloc(10);\n"
+                                "    if (x) { free(p); }\n"
+                                "}");
+        tokenizer.tokenize(istr, "test.cpp");
+        tokenizer.simplifyTokenList();
+
+        // the tokenizer itself is within the limit
+        settings._maxTokens = (unsigned int)tokenizer.peakTokenCount();
+        tokenizer.checkLimits();
+
+        CheckMemoryLeakInFunction checkMemoryLeak(&tokenizer, &settings, this);
+        ASSERT_THROW(checkMemoryLeak.check(), InternalError);
+        ASSERT(tokenizer.peakTokenCount() > settings._maxTokens);
+    }
 };
 
 static TestMemleakInFunction testMemleakInFunction;
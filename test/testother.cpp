@@ -6719,7 +6719,7 @@ private:
               "{\n"
               "   int a = 123 << -1;\n"
               "}");
-        TODO_ASSERT_EQUALS("[test.cpp:3]: (error) Shifting by a negative value.\n", "", errout.str());
+        ASSERT_EQUALS("[test.cpp:3]: (error) Shifting by a negative value.\n", errout.str());
         check("void foo()\n"
               "{\n"
               "   std::cout << -1;\n"
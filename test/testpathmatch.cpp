@@ -56,6 +56,7 @@ private:
         TEST_CASE(filemaskpath2);
         TEST_CASE(filemaskpath3);
         TEST_CASE(filemaskpath4);
+        TEST_CASE(mixedmasks);
     }
 
     void emptymaskemptyfile() const {
@@ -246,6 +247,24 @@ private:
         PathMatch match(masks);
         ASSERT(!match.Match("bar/foo.cpp"));
     }
+
+    void mixedmasks() const {
+        std::vector<std::string> masks;
+        masks.push_back("foo.cpp");
+        masks.push_back("src/lib/");
+        masks.push_back("lib/bar.cpp");
+        masks.push_back("a/");
+        PathMatch match(masks);
+        ASSERT(match.Match("project/src/lib/file.cpp"));
+        ASSERT(match.Match("src/lib/inner/file.cpp"));
+        ASSERT(!match.Match("project/src/library/file.cpp"));
+        ASSERT(!match.Match("project/mysrc/lib/file.cpp"));
+        ASSERT(match.Match("project/a/file.cpp"));
+        ASSERT(!match.Match("project/ba/file.cpp"));
+        ASSERT(match.Match("other/lib/bar.cpp"));
+        ASSERT(match.Match("x/foo.cpp"));
+        ASSERT(!match.Match("x/foo.c"));
+    }
 };
 
 REGISTER_TEST(TestPathMatch)
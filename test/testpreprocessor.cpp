@@ -259,6 +259,7 @@ private:
 
         // Test Preprocessor::simplifyCondition
         TEST_CASE(simplifyCondition);
+        TEST_CASE(simplifyConditionEvaluate);
         TEST_CASE(invalidElIf); // #2942 segfault
 
         // Defines are given: test Preprocessor::handleIncludes
@@ -3186,6 +3187,48 @@ private:
         ASSERT_EQUALS("1", condition);
     }
 
+    std::string simplifyCondition(const std::map<std::string, std::string> &cfg, const char condition[], bool match) {
+        Preprocessor preprocessor(NULL, this);
+        std::string str(condition);
+        preprocessor.simplifyCondition(cfg, str, match);
+        return str;
+    }
+
+    void simplifyConditionEvaluate() {
+        std::map<std::string, std::string> cfg;
+        cfg["A"] = "2";
+        cfg["B"] = "";
+        cfg["C"] = "(1 << 4)";
+        cfg["D"] = "0x10U";
+
+        ASSERT_EQUALS("1", simplifyCondition(cfg, "A * 3 == 6", false));
+        ASSERT_EQUALS("0", simplifyCondition(cfg, "A > 3 || !defined(B)", false));
+        ASSERT_EQUALS("1", simplifyCondition(cfg, "C == D && B", false));
+        ASSERT_EQUALS("1", simplifyCondition(cfg, "(A ? C : 0) / 8 == A", false));
+        ASSERT_EQUALS("1", simplifyCondition(cfg, "-A % 3 == -2 && ~0 == -1", false));
+        ASSERT_EQUALS("0", simplifyCondition(cfg, "defined X && A", true));
+        ASSERT_EQUALS("defined X && A", simplifyCondition(cfg, "defined X && A", false));
+        ASSERT_EQUALS("1 / 0", simplifyCondition(cfg, "1 / 0", true));
+
+        // unsigned operands and overflows are left to the tokenizer
+        ASSERT_EQUALS("0", simplifyCondition(cfg, "-1 < 0U", true));
+        ASSERT_EQUALS("1", simplifyCondition(cfg, "-1 < 0", true));
+        ASSERT_EQUALS("1", simplifyCondition(cfg, "-1 > D", true));
+        ASSERT_EQUALS("1 << 62 << 1 > 0", simplifyCondition(cfg, "1 << 62 << 1 > 0", true));
+        ASSERT_EQUALS("-A << 1 < 0", simplifyCondition(cfg, "-A << 1 < 0", true));
+        ASSERT_EQUALS("1", simplifyCondition(cfg, "(1 << 62) > 0", true));
+
+        // cached results depend on the values of the macros
+        Preprocessor preprocessor(NULL, this);
+        std::string condition("A == 2");
+        preprocessor.simplifyCondition(cfg, condition, true);
+        ASSERT_EQUALS("1", condition);
+        cfg["A"] = "3";
+        condition = "A == 2";
+        preprocessor.simplifyCondition(cfg, condition, true);
+        ASSERT_EQUALS("0", condition);
+    }
+
     void invalidElIf() {
         // #2942 - segfault
         const char code[] = "#elif (){\n";
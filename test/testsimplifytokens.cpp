@@ -127,6 +127,10 @@ private:
         TEST_CASE(template33);  // #3818 - inner templates in template instantiation not handled well
         TEST_CASE(template34);  // #3706 - namespace => hang
         TEST_CASE(template35);  // #4074 - A<'x'> a;
+        TEST_CASE(template36);  // instantiation in expanded code of a template declared before
+        TEST_CASE(template37);  // out-of-class member function, several instantiations
+        TEST_CASE(template38);  // recursive instantiation never ends
+        TEST_CASE(template_limit);
         TEST_CASE(template_unhandled);
         TEST_CASE(template_default_parameter);
         TEST_CASE(template_default_type);
@@ -292,6 +296,7 @@ private:
         TEST_CASE(simplifyTypedef105); // ticket #3616
         TEST_CASE(simplifyTypedef106); // ticket #3619
         TEST_CASE(simplifyTypedef107); // ticket #3963 - bad code => segmentation fault
+        TEST_CASE(simplifyTypedef108); // name of a later typedef is copied to the uses
 
         TEST_CASE(simplifyTypedefFunction1);
         TEST_CASE(simplifyTypedefFunction2); // ticket #1685
@@ -358,6 +363,7 @@ private:
         TEST_CASE(enum34); // ticket #4141 (division by zero)
         TEST_CASE(enum35); // ticket #3953 (avoid simplification of type)
         TEST_CASE(enum36); // ticket #4378
+        TEST_CASE(enum37); // enumerator value copied into a later enum
         TEST_CASE(enumscope1); // ticket #3949
         TEST_CASE(duplicateDefinition); // ticket #3565
 
@@ -2241,6 +2247,51 @@ private:
         ASSERT_EQUALS("A<'x'> a ; class A<'x'> { }", tok(code));
     }
 
+    void template36() { // A<int> is only found when B<int> is expanded
+        const char code[] = "template <class T> struct B { const A<T> *a; };\n"
+                            "template <class T> struct A { T x; };\n"
+                            "B<int> b;";
+        ASSERT_EQUALS("B<int> b ; struct B<int> { const A<int> * a ; } struct A<int> { int x ; }", tok(code));
+    }
+
+    void template37() {
+        const char code[] = "template <class T> struct A { T f(); };\n"
+                            "template <class T> T A<T>::f() { return 0; }\n"
+                            "A<int> a;\n"
+                            "A<char> c;\n"
+                            "A<A<int> > aa;";
+        ASSERT_EQUALS("template < class T > T A < T > :: f ( ) { return 0 ; } "
+                      "A<int> a ; A<char> c ; A<A<int>> aa ; "
+                      "struct A<int> { int f ( ) ; } A<int> :: f ( ) { return 0 ; } "
+                      "struct A<char> { char f ( ) ; } A<char> :: f ( ) { return 0 ; } "
+                      "struct A<A<int>> { A<int> f ( ) ; } A<A<int>> :: f ( ) { return 0 ; }", tok(code));
+    }
+
+    void template38() { // the depth of nested instantiations is limited
+        const char code[] = "template <int N> struct F { F<N+1> x; };\n"
+                            "F<0> f;";
+        const std::string expanded(tok(code));
+        ASSERT(expanded.find("struct F<100> { F < 101 > x ; }") != std::string::npos);
+        ASSERT(expanded.find("struct F<101>") == std::string::npos);
+    }
+
+    void template_limit() {
+        errout.str("");
+
+        Settings settings;
+        settings.addEnabled("information");
+        settings._maxTemplateInstantiations = 1;
+        Tokenizer tokenizer(&settings, this);
+
+        std::istringstream istr("template <class T> struct A { T x; };\n"
+                                "A<int> a;\n"
+                                "A<char> c;");
+        tokenizer.tokenize(istr, "test.cpp");
+
+        ASSERT_EQUALS("A<int> a ; A < char > c ; struct A<int> { int x ; }", tokenizer.tokens()->stringifyList(0, false));
+        ASSERT_EQUALS("[test.cpp:3]: (information) Template instantiation 'A<char>' is not expanded, the limit of 1 instantiations or 1000000 tokens is reached.\n", errout.str());
+    }
+
     void template_unhandled() {
         // An unhandled template usage should be simplified..
         ASSERT_EQUALS("x<int> ( ) ;", tok("x<int>();"));
@@ -5916,6 +5967,14 @@ private:
         ASSERT_EQUALS("[test.cpp:1]: (error) syntax error\n", errout.str());
     }
 
+    void simplifyTypedef108() {
+        const char code[] = "typedef Foo Bar;\n"
+                            "typedef int Foo;\n"
+                            "Bar x;";
+        ASSERT_EQUALS("int x ;", tok(code));
+        ASSERT_EQUALS("", errout.str());
+    }
+
     void simplifyTypedefFunction1() {
         {
             const char code[] = "typedef void (*my_func)();\n"
@@ -7289,6 +7348,13 @@ private:
         ASSERT_EQUALS("struct X { X ( int ) { int y ; y = ( int ) 1 ; } } ;", checkSimplifyEnum(code));
     }
 
+    void enum37() {
+        const char code[] = "enum A { a = x + 1 };\n"
+                            "enum B { b = a, c };\n"
+                            "int i = c;";
+        ASSERT_EQUALS("int i ; i = x + 2 ;", checkSimplifyEnum(code));
+    }
+
     void enumscope1() { // #3949 - don't simplify enum from one function in another function
         const char code[] = "void foo() { enum { A = 0, B = 1 }; }\n"
                             "void bar() { int a = A; }";
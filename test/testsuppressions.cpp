@@ -103,6 +103,18 @@ private:
             ASSERT_EQUALS(true, suppressions.isSuppressed("errorid", "abc.cpp", 1));
             ASSERT_EQUALS(true, suppressions.isSuppressed("errorid", "abc.cpp", 2));
         }
+
+        // Check that globs added after a lookup are taken into account
+        {
+            Suppressions suppressions;
+            ASSERT_EQUALS("", suppressions.addSuppression("errorid", "x*.cpp"));
+            ASSERT_EQUALS(false, suppressions.isSuppressed("errorid", "abc.cpp", 1));
+            ASSERT_EQUALS(true, suppressions.isSuppressed("errorid", "xyz.cpp", 1));
+            ASSERT_EQUALS("", suppressions.addSuppression("errorid", "a*.cpp", 2));
+            ASSERT_EQUALS(false, suppressions.isSuppressed("errorid", "abc.cpp", 1));
+            ASSERT_EQUALS(true, suppressions.isSuppressed("errorid", "abc.cpp", 2));
+            ASSERT_EQUALS(true, suppressions.isSuppressed("errorid", "xyz.cpp", 2));
+        }
     }
 
     void suppressionsFileNameWithExtraPath() {
@@ -50,6 +50,7 @@ private:
         TEST_CASE(strValue);
 
         TEST_CASE(deleteLast);
+        TEST_CASE(tokenCounters);
         TEST_CASE(nextArgument);
         TEST_CASE(eraseTokens);
 
@@ -268,12 +269,37 @@ private:
 
 
     void deleteLast() {
-        Token *tokensBack = 0;
+        TokensBack tokensBack;
         Token tok(&tokensBack);
         tok.insertToken("aba");
-        ASSERT_EQUALS(true, tokensBack == tok.next());
+        ASSERT_EQUALS(true, tokensBack.back == tok.next());
         tok.deleteNext();
-        ASSERT_EQUALS(true, tokensBack == &tok);
+        ASSERT_EQUALS(true, tokensBack.back == &tok);
+    }
+
+    void tokenCounters() {
+        TokensBack tokensBack;
+        Token tok(&tokensBack);
+        tok.str("x");
+        tok.insertToken("a");
+        tok.insertToken("b");
+        tok.deleteNext();
+        tok.insertToken("c");
+        ASSERT_EQUALS(4U, tokensBack.allocated);
+        ASSERT_EQUALS(3U, tokensBack.live);
+        ASSERT_EQUALS(3U, tokensBack.peakLive);
+        tok.deleteNext(2);
+        ASSERT_EQUALS(1U, tokensBack.live);
+        ASSERT_EQUALS(3U, tokensBack.peakLive);
+
+        // tokens of another list are not counted
+        TokensBack otherBack;
+        Token other(&otherBack);
+        other.str("y");
+        other.insertToken("d");
+        ASSERT_EQUALS(4U, tokensBack.allocated);
+        ASSERT_EQUALS(2U, otherBack.allocated);
+        other.deleteNext();
     }
 
     void nextArgument() {
@@ -15,8 +15,10 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <cstdlib>
 #include <cstring>
@@ -25,6 +27,14 @@
 #include "cppcheck.h"
 #include "mathlib.h"
 
+#if (defined(__GNUC__) || defined(__sun)) && !defined(__MINGW32__)
+#define THREADING_MODEL_FORK
+#include <csignal>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 class CppcheckExecutor : public ErrorLogger {
 private:
     CppCheck cppcheck;
@@ -81,9 +91,29 @@ struct ReduceSettings {
     bool hang;
     unsigned int maxtime;
     const char *defines;
+    unsigned int jobs;
 };
 
-static bool test(const ReduceSettings &settings, const std::vector<std::string> &filedata, const std::size_t line1, const std::size_t line2)
+/** Results of the tested candidates. Key is the hash of the candidate code. */
+static std::map<unsigned long long, bool> testedCandidates;
+
+/** FNV-1a hash of the code that is written for a candidate */
+static unsigned long long candidateHash(const std::vector<std::string> &filedata, const std::size_t line1, const std::size_t line2)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < filedata.size(); i++) {
+        if (i < line1 || i > line2) {
+            const std::string &line = filedata[i];
+            for (std::string::size_type pos = 0; pos < line.size(); ++pos)
+                hash = (hash ^ (unsigned char)line[pos]) * 1099511628211ULL;
+        }
+        hash = (hash ^ (unsigned char)'\n') * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/** temporary file for a worker, worker 0 is the main process */
+static std::string tempfilename(const ReduceSettings &settings, unsigned int worker)
 {
     std::string path(settings.filename);
     if (path.find_first_of("\\/") != std::string::npos)
@@ -91,14 +121,31 @@ static bool test(const ReduceSettings &settings, const std::vector<std::string>
     else
         path.clear();
 
-    const std::string tempfilename(path + "__temp__" + std::strrchr(settings.filename,'.'));
-    std::ofstream fout(tempfilename.c_str());
+    const std::string name(worker == 0U ? std::string("__temp__") : ("__temp" + MathLib::longToString(worker) + "__"));
+    return path + name + std::strrchr(settings.filename,'.');
+}
+
+static void writefile(const std::string &filename, const std::vector<std::string> &filedata, const std::size_t line1, const std::size_t line2)
+{
+    std::ofstream fout(filename.c_str());
     for (std::size_t i = 0; i < filedata.size(); i++)
         fout << ((i>=line1 && i<=line2) ? "" : filedata[i]) << std::endl;
-    fout.close();
+}
+
+static bool test(const ReduceSettings &settings, const std::vector<std::string> &filedata, const std::size_t line1, const std::size_t line2)
+{
+    const unsigned long long hash = candidateHash(filedata, line1, line2);
+    const std::map<unsigned long long, bool>::const_iterator tested = testedCandidates.find(hash);
+    if (tested != testedCandidates.end())
+        return tested->second;
+
+    const std::string filename(tempfilename(settings, 0U));
+    writefile(filename, filedata, line1, line2);
 
     CppcheckExecutor cppcheck(settings.defines, settings.linenr, settings.hang);
-    return cppcheck.run(tempfilename.c_str(), settings.maxtime);
+    const bool result = cppcheck.run(filename.c_str(), settings.maxtime);
+    testedCandidates[hash] = result;
+    return result;
 }
 
 static bool test(const ReduceSettings &settings, const std::vector<std::string> &filedata, const std::size_t line)
@@ -106,6 +153,75 @@ static bool test(const ReduceSettings &settings, const std::vector<std::string>
     return test(settings, filedata, line, line);
 }
 
+/**
+ * Test candidates where lines [first,second] are removed. Up to
+ * settings.jobs candidates are tested at the same time in worker
+ * processes.
+ * @return index of the first candidate that reproduces the problem,
+ * candidates.size() if there is no such candidate
+ */
+static std::size_t testCandidates(const ReduceSettings &settings, const std::vector<std::string> &filedata, const std::vector<std::pair<std::size_t, std::size_t> > &candidates)
+{
+#ifdef THREADING_MODEL_FORK
+    if (settings.jobs > 1U) {
+        for (std::size_t first = 0; first < candidates.size(); first += settings.jobs) {
+            const std::size_t last = std::min(candidates.size(), first + settings.jobs);
+
+            std::vector<unsigned long long> hashes;
+            std::vector<pid_t> pids;
+            for (std::size_t c = first; c < last; ++c) {
+                const unsigned long long hash = candidateHash(filedata, candidates[c].first, candidates[c].second);
+                hashes.push_back(hash);
+                pids.push_back(0);
+                if (testedCandidates.find(hash) != testedCandidates.end())
+                    continue;
+
+                std::cout.flush();
+                const pid_t pid = fork();
+                if (pid == 0) {
+                    // worker: test the candidate in its own temporary file. The
+                    // alarm terminates hangs that don't report progress.
+                    const std::string filename(tempfilename(settings, (unsigned int)(c - first + 1U)));
+                    writefile(filename, filedata, candidates[c].first, candidates[c].second);
+                    alarm(settings.maxtime + 10U);
+                    CppcheckExecutor cppcheck(settings.defines, settings.linenr, settings.hang);
+                    const bool result = cppcheck.run(filename.c_str(), settings.maxtime);
+                    std::cout.flush();
+                    _exit(result ? EXIT_SUCCESS : EXIT_FAILURE);
+                } else if (pid < 0) {
+                    // fork failed, test the candidate here instead
+                    test(settings, filedata, candidates[c].first, candidates[c].second);
+                } else {
+                    pids.back() = pid;
+                }
+            }
+
+            for (std::size_t i = 0; i < pids.size(); ++i) {
+                if (pids[i] <= 0)
+                    continue;
+                int status = 0;
+                waitpid(pids[i], &status, 0);
+                const bool result = (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) ||
+                                    (settings.hang && WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM);
+                testedCandidates[hashes[i]] = result;
+            }
+
+            for (std::size_t i = 0; i < hashes.size(); ++i) {
+                if (testedCandidates[hashes[i]])
+                    return first + i;
+            }
+        }
+        return candidates.size();
+    }
+#endif
+
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        if (test(settings, filedata, candidates[c].first, candidates[c].second))
+            return c;
+    }
+    return candidates.size();
+}
+
 static void printstr(const std::vector<std::string> &filedata, int i1, int i2)
 {
     std::cout << filedata.size();
@@ -471,26 +587,40 @@ static bool removeUnusedDefines(const ReduceSettings &settings, std::vector<std:
     return changed;
 }
 
-static bool removeSingleLines(const ReduceSettings &settings, std::vector<std::string> &filedata)
+// Remove chunks of lines (ddmin). The chunks are halved until single
+// lines are tried.
+static bool removeChunks(const ReduceSettings &settings, std::vector<std::string> &filedata)
 {
     bool changed = false;
 
-    bool decl = true;
-    for (std::size_t i = 0; i < filedata.size(); ++i) {
-        const std::string line = filedata[i];
-        if (line.empty())
-            continue;
+    std::size_t chunks = 2;
+    for (;;) {
+        std::vector<std::size_t> lines;
+        for (std::size_t i = 0; i < filedata.size(); ++i) {
+            if (!filedata[i].empty())
+                lines.push_back(i);
+        }
+        if (lines.empty())
+            break;
 
-        const char endChar = line[line.size() - 1U];
-        if (decl && endChar == ';') {
-            if (test(settings, filedata, i)) {
-                std::cout << "Removed statement at line " << i << std::endl;
+        chunks = std::min(chunks, lines.size());
+        const std::size_t chunkSize = (lines.size() + chunks - 1U) / chunks;
+
+        std::vector<std::pair<std::size_t, std::size_t> > candidates;
+        for (std::size_t start = 0; start < lines.size(); start += chunkSize)
+            candidates.push_back(std::make_pair(lines[start], lines[std::min(start + chunkSize, lines.size()) - 1U]));
+
+        const std::size_t c = testCandidates(settings, filedata, candidates);
+        if (c < candidates.size()) {
+            for (std::size_t i = candidates[c].first; i <= candidates[c].second; ++i)
                 filedata[i].clear();
-            } else {
-                std::cout << "Kept statement at line " << i << std::endl;
-            }
+            std::cout << "Removed lines " << candidates[c].first << "-" << candidates[c].second << std::endl;
+            changed = true;
+            chunks = std::max(chunks - 1U, (std::size_t)2U);
+        } else if (chunkSize == 1U) {
+            break;
         } else {
-            decl = bool (endChar == ';' || endChar == '{' || endChar == '}');
+            chunks = std::min(2U * chunks, lines.size());
         }
     }
 
@@ -579,6 +709,7 @@ int main(int argc, char *argv[])
     bool print = false;
     struct ReduceSettings settings = {0};
     settings.maxtime = 300;  // default timeout = 5 minutes
+    settings.jobs = 1;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--stdout") == 0)
@@ -589,6 +720,8 @@ int main(int argc, char *argv[])
             settings.maxtime = std::atoi(argv[i] + 10);
         else if (strncmp(argv[i],"--cfg=",6)==0)
             settings.defines = argv[i] + 6;
+        else if (strncmp(argv[i],"-j",2)==0 && MathLib::isInt(argv[i] + 2) && std::atoi(argv[i] + 2) > 0)
+            settings.jobs = std::atoi(argv[i] + 2);
         else if (settings.filename==NULL && strchr(argv[i],'.'))
             settings.filename = argv[i];
         else if (settings.linenr == 0U && MathLib::isInt(argv[i]))
@@ -601,7 +734,7 @@ int main(int argc, char *argv[])
 
     if ((!settings.hang && settings.linenr == 0U) || settings.filename == NULL) {
         std::cerr << "Syntax:" << std::endl
-                  << argv[0] << " [--stdout] [--cfg=X] [--hang] [--maxtime=60] filename [linenr]" << std::endl;
+                  << argv[0] << " [--stdout] [--cfg=X] [--hang] [--maxtime=60] [-j4] filename [linenr]" << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -652,6 +785,7 @@ int main(int argc, char *argv[])
                     filedata[i].clear();
                     filedata.insert(filedata.begin()+i, data.begin(), data.end());
                     settings.linenr += data.size();
+                    testedCandidates.clear();
                 }
             }
         }
@@ -660,16 +794,15 @@ int main(int argc, char *argv[])
     bool changed = true;
     while (changed) {
         changed = false;
+        changed |= removeChunks(settings,filedata);
         changed |= removeMacrosInGlobalScope(settings,filedata);
         changed |= removeBlocksOfCode(settings,filedata);
         changed |= removeClassAndStructMembers(settings,filedata);
         changed |= removeIfEndIf(settings,filedata);
         changed |= removeUnusedDefines(settings,filedata);
 
-        if (settings.hang) {
-            changed |= removeSingleLines(settings,filedata);
+        if (settings.hang)
             changed |= cleanupStatements(settings,filedata);
-        }
     }
 
     // Write resulting code..